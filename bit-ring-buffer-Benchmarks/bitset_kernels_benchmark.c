@@ -0,0 +1,114 @@
+//
+//  bitset_kernels_benchmark.c
+//  bit-ring-buffer-Benchmarks
+//
+//  Created by agent on 2026-10-18.
+//
+//  Compares the popcount and shift kernels this CPU supports.
+//
+//  Usage: bitset_kernels_benchmark [bit_count] [repetitions]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bitset.h"
+#include "bitset-kernels.h"
+
+
+static double
+now_in_seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int
+main(int argc, const char *argv[])
+{
+	const size_t bit_count = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 10) : (size_t)1 << 28;
+	const size_t repetitions = (argc > 2) ? (size_t)strtoull(argv[2], NULL, 10) : 10;
+	
+	const size_t unit_count = bit_count / (sizeof(size_t) * JX_BITSET_BITS_PER_BYTE);
+	
+	size_t *units = malloc((unit_count > 0 ? unit_count : 1) * sizeof(size_t));
+	if (units == NULL) {
+		fprintf(stderr, "Cannot allocate %zu units.\n", unit_count);
+		return EXIT_FAILURE;
+	}
+	memset(units, 0xa5, unit_count * sizeof(size_t));
+	
+	const jx_bitset_kernels *kernels[8];
+	const size_t kernel_count = jx_bitset_get_supported_kernels(kernels, 8);
+	
+	printf("bits: %zu, repetitions: %zu, selected: %s\n", bit_count, repetitions, jx_bitset_get_kernels()->name);
+	printf("%10s %14s %14s %12s %12s\n", "kernels", "popcount ms", "shift ms", "popcount GB/s", "shift GB/s");
+	
+	const double gigabytes = (double)(unit_count * sizeof(size_t)) * 1e-9;
+	
+	for (size_t k = 0; k < kernel_count; k += 1) {
+		double popcount_time = 0.0;
+		double shift_time = 0.0;
+		size_t checksum = 0;
+		
+		for (size_t r = 0; r < repetitions; r += 1) {
+			double start = now_in_seconds();
+			checksum += kernels[k]->popcount_units(units, unit_count);
+			popcount_time += now_in_seconds() - start;
+			
+			start = now_in_seconds();
+			checksum += kernels[k]->shift_units_forward(units, unit_count, r & 1);
+			shift_time += now_in_seconds() - start;
+		}
+		
+		printf("%10s %14.3f %14.3f %12.2f %12.2f   (%zu)\n",
+			   kernels[k]->name,
+			   popcount_time * 1e3 / (double)repetitions,
+			   shift_time * 1e3 / (double)repetitions,
+			   gigabytes * (double)repetitions / popcount_time,
+			   gigabytes * (double)repetitions / shift_time,
+			   checksum);
+	}
+	
+	free(units);
+	
+	return EXIT_SUCCESS;
+}
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
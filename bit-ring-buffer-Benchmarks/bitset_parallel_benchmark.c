@@ -0,0 +1,147 @@
+//
+//  bitset_parallel_benchmark.c
+//  bit-ring-buffer-Benchmarks
+//
+//  Created by agent on 2026-10-18.
+//
+//  Measures how the parallel bitset operations scale from one thread up to
+//  `max_thread_count` threads.
+//
+//  Usage: bitset_parallel_benchmark [bit_count] [max_thread_count] [repetitions]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bitset.h"
+
+
+static double
+now_in_seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static size_t
+parse_size_argument(int argc, const char *argv[], int index, size_t default_value)
+{
+	if (argc > index) {
+		return (size_t)strtoull(argv[index], NULL, 10);
+	}
+	else {
+		return default_value;
+	}
+}
+
+int
+main(int argc, const char *argv[])
+{
+	const long online_processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+	
+	const size_t bit_count = parse_size_argument(argc, argv, 1, (size_t)1 << 30);
+	const size_t max_thread_count = parse_size_argument(argc, argv, 2, (online_processor_count > 0) ? (size_t)online_processor_count : 1);
+	const size_t repetitions = parse_size_argument(argc, argv, 3, 5);
+	
+	jx_bitset *set = jx_bitset_new(bit_count);
+	if ((set == NULL) || (set->bits == NULL)) {
+		fprintf(stderr, "Cannot allocate a bitset with %zu bits.\n", bit_count);
+		return EXIT_FAILURE;
+	}
+	
+	printf("bits: %zu, repetitions: %zu\n", bit_count, repetitions);
+	printf("%8s %14s %14s %14s %10s\n", "threads", "popcount ms", "set_all ms", "shift ms", "speedup");
+	
+	double single_thread_total = 0.0;
+	
+	for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count += 1) {
+		jx_thread_pool *pool = jx_thread_pool_new(thread_count);
+		if (pool == NULL) {
+			fprintf(stderr, "Cannot start %zu threads.\n", thread_count);
+			break;
+		}
+		
+		double popcount_time = 0.0;
+		double set_all_time = 0.0;
+		double shift_time = 0.0;
+		size_t checksum = 0;
+		
+		for (size_t r = 0; r < repetitions; r += 1) {
+			double start = now_in_seconds();
+			jx_bitset_set_all_to_true_parallel(set, pool);
+			set_all_time += now_in_seconds() - start;
+			
+			start = now_in_seconds();
+			jx_bitset_shift_all_bits_forward_parallel(set, pool);
+			shift_time += now_in_seconds() - start;
+			
+			start = now_in_seconds();
+			checksum += jx_bitset_popcount_parallel(set, pool);
+			popcount_time += now_in_seconds() - start;
+		}
+		
+		const double total = popcount_time + set_all_time + shift_time;
+		if (thread_count == 1) {
+			single_thread_total = total;
+		}
+		
+		const double ms_per_repetition = 1e3 / (double)repetitions;
+		printf("%8zu %14.3f %14.3f %14.3f %9.2fx\n",
+			   thread_count,
+			   popcount_time * ms_per_repetition,
+			   set_all_time * ms_per_repetition,
+			   shift_time * ms_per_repetition,
+			   single_thread_total / total);
+		
+		if (checksum != repetitions * (bit_count - 1)) {
+			fprintf(stderr, "Unexpected popcount with %zu threads.\n", thread_count);
+			jx_thread_pool_free(pool);
+			jx_bitset_free(set);
+			return EXIT_FAILURE;
+		}
+		
+		jx_thread_pool_free(pool);
+	}
+	
+	jx_bitset_free(set);
+	
+	return EXIT_SUCCESS;
+}
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
@@ -0,0 +1,1110 @@
+//
+//  bit_ring_buffer_fuzz.c
+//  bit-ring-buffer-Fuzz
+//
+//  Created by agent on 2026-10-18.
+//
+//  Differential fuzzer: replays a stream of operations against the ring buffer
+//  and the bitset, and against a naive `bool` array model of each.
+//  Every bit, count and popcount is compared after every step.
+//
+//  Both builds below use the library as CMake builds it, with the kernels
+//  for every instruction set the compiler supports.
+//
+//  Standalone, with random streams (runs anywhere, e.g. under ASan/UBSan):
+//    cmake -S . -B build -DJX_ENABLE_SANITIZERS=ON
+//    cmake --build build --target bit_ring_buffer_fuzz
+//    build/bit_ring_buffer_fuzz [iterations] [seed]
+//
+//  With libFuzzer:
+//    cmake -S . -B build-fuzz -DCMAKE_C_COMPILER=clang -DJX_BUILD_LIBFUZZER=ON -DJX_ENABLE_SANITIZERS=ON
+//    cmake --build build-fuzz --target bit_ring_buffer_libfuzzer
+//    build-fuzz/bit_ring_buffer_libfuzzer
+//
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "bitset-kernels.h"
+#include "bit-ring-buffer.h"
+#include "bit-ring-buffer-snapshot.h"
+#include "bit-ring-buffer-statistics.h"
+
+
+/* Sizes around every byte, unit, inline storage and snapshot block boundary */
+static const size_t fuzz_bit_counts[] = {
+	1, 2, 3, 4, 5, 6, 7, 8, 9,
+	15, 16, 17,
+	31, 32, 33,
+	63, 64, 65,
+	127, 128, 129,
+	191, 192, 193,
+	511, 512, 513,
+	1023, 1024, 1025,
+	4095, 4096,
+};
+
+#define FUZZ_BIT_COUNT_COUNT (sizeof(fuzz_bit_counts) / sizeof(fuzz_bit_counts[0]))
+
+/* Rings grown by the fuzzer stop growing here, to keep each run fast. */
+#define FUZZ_MAX_BIT_COUNT	4096
+
+
+typedef struct fuzz_input {
+	const uint8_t *data;
+	size_t  size;
+	size_t  offset;
+} fuzz_input;
+
+static bool
+fuzz_input_is_empty(fuzz_input *input)
+{
+	return (input->offset >= input->size);
+}
+
+static uint8_t
+fuzz_input_next_byte(fuzz_input *input)
+{
+	if (fuzz_input_is_empty(input)) {
+		return 0;
+	}
+	
+	return input->data[input->offset++];
+}
+
+static size_t
+fuzz_input_next_size(fuzz_input *input)
+{
+	const size_t low = fuzz_input_next_byte(input);
+	const size_t high = fuzz_input_next_byte(input);
+	
+	return (high << 8) | low;
+}
+
+static uint64_t
+xorshift64(uint64_t *state)
+{
+	uint64_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*state = x;
+	
+	return x;
+}
+
+
+static size_t fuzz_step;
+
+static void
+fuzz_fail(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	fprintf(stderr, "Mismatch at step %zu: ", fuzz_step);
+	vfprintf(stderr, format, args);
+	fprintf(stderr, "\n");
+	va_end(args);
+	
+	abort();
+}
+
+
+/*-----------------------------------------------------------------------
+ * Ring buffer model
+ */
+
+typedef struct ring_model {
+	bool   *storage;
+	size_t  bit_count;
+	size_t  used_bit_count;
+	size_t  read_index;
+	size_t  write_index;
+} ring_model;
+
+static void
+ring_model_init(ring_model *model, size_t bit_count)
+{
+	model->storage = calloc(bit_count, sizeof(bool));
+	model->bit_count = bit_count;
+	model->used_bit_count = 0;
+	model->read_index = 0;
+	model->write_index = 0;
+}
+
+static void
+ring_model_done(ring_model *model)
+{
+	free(model->storage);
+}
+
+static bool
+ring_model_get(ring_model *model, size_t index)
+{
+	return model->storage[(model->read_index + index) % model->bit_count];
+}
+
+static bool
+ring_model_add(ring_model *model, bool element)
+{
+	if (model->used_bit_count == model->bit_count) {
+		return false;
+	}
+	
+	model->storage[model->write_index] = element;
+	model->write_index = (model->write_index + 1) % model->bit_count;
+	model->used_bit_count += 1;
+	
+	return true;
+}
+
+static void
+ring_model_add_with_overwrite(ring_model *model, bool element)
+{
+	if (model->used_bit_count == model->bit_count) {
+		// The oldest bit is replaced by the newest.
+		model->read_index = (model->read_index + 1) % model->bit_count;
+		model->used_bit_count -= 1;
+	}
+	
+	ring_model_add(model, element);
+}
+
+static int
+ring_model_pop(ring_model *model)
+{
+	if (model->used_bit_count == 0) {
+		return -1;
+	}
+	
+	const bool element = model->storage[model->read_index];
+	model->read_index = (model->read_index + 1) % model->bit_count;
+	model->used_bit_count -= 1;
+	
+	return element;
+}
+
+/* Resizing moves the window to index 0 of fresh, zeroed storage. */
+static void
+ring_model_resize(ring_model *model, size_t bit_count)
+{
+	bool *storage = calloc(bit_count, sizeof(bool));
+	
+	for (size_t i = 0; i < model->used_bit_count; i += 1) {
+		storage[i] = ring_model_get(model, i);
+	}
+	
+	free(model->storage);
+	model->storage = storage;
+	model->bit_count = bit_count;
+	model->read_index = 0;
+	model->write_index = model->used_bit_count % bit_count;
+}
+
+static void
+compare_ring(jx_bit_ring_buffer *buf, ring_model *model)
+{
+	if (jx_bit_ring_buffer_get_allocated_size(buf) != model->bit_count) {
+		fuzz_fail("ring size %zu, expected %zu", jx_bit_ring_buffer_get_allocated_size(buf), model->bit_count);
+	}
+	
+	if (jx_bit_ring_buffer_get_used_bit_count(buf) != model->used_bit_count) {
+		fuzz_fail("ring used bit count %zu, expected %zu", jx_bit_ring_buffer_get_used_bit_count(buf), model->used_bit_count);
+	}
+	
+	if (jx_bit_ring_buffer_is_empty(buf) != (model->used_bit_count == 0) ||
+		jx_bit_ring_buffer_is_full(buf) != (model->used_bit_count == model->bit_count)) {
+		fuzz_fail("ring empty/full state");
+	}
+	
+	if ((buf->read_index != model->read_index) || (buf->write_index != model->write_index)) {
+		fuzz_fail("ring indexes %zu/%zu, expected %zu/%zu",
+				  buf->read_index, buf->write_index, model->read_index, model->write_index);
+	}
+	
+	size_t popcount = 0;
+	
+	for (size_t i = 0; i < model->bit_count; i += 1) {
+		if (jx_bitset_get(&buf->bitset, i) != model->storage[i]) {
+			fuzz_fail("ring bit %zu of %zu", i, model->bit_count);
+		}
+		
+		popcount += model->storage[i];
+	}
+	
+	if (jx_bit_ring_buffer_population_count(buf) != popcount) {
+		fuzz_fail("ring popcount %zu, expected %zu", jx_bit_ring_buffer_population_count(buf), popcount);
+	}
+	
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+	size_t edge_counts[2] = { 0, 0 };
+	
+	for (size_t i = 1; i < model->used_bit_count; i += 1) {
+		const bool previous = ring_model_get(model, i - 1);
+		const bool element = ring_model_get(model, i);
+		
+		if (previous != element) {
+			edge_counts[element] += 1;
+		}
+	}
+	
+	if ((jx_bit_ring_buffer_get_rising_edge_count(buf) != edge_counts[1]) ||
+		(jx_bit_ring_buffer_get_falling_edge_count(buf) != edge_counts[0])) {
+		fuzz_fail("ring edge counts %zu/%zu, expected %zu/%zu",
+				  jx_bit_ring_buffer_get_rising_edge_count(buf), jx_bit_ring_buffer_get_falling_edge_count(buf),
+				  edge_counts[1], edge_counts[0]);
+	}
+#endif
+}
+
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+/* Compare the statistics of the newest `bit_count` bits against a bit-by-bit scan of the model. */
+static void
+fuzz_window_statistics(jx_bit_ring_buffer *buf, ring_model *model, size_t bit_count)
+{
+	jx_bit_ring_buffer_window_statistics statistics;
+	jx_bit_ring_buffer_get_window_statistics(buf, bit_count, &statistics);
+	
+	if (bit_count > model->used_bit_count) {
+		bit_count = model->used_bit_count;
+	}
+	
+	size_t one_count = 0;
+	size_t edge_counts[2] = { 0, 0 };
+	size_t runs[2] = { 0, 0 };
+	size_t longest_runs[2] = { 0, 0 };
+	
+	for (size_t i = model->used_bit_count - bit_count; i < model->used_bit_count; i += 1) {
+		const bool element = ring_model_get(model, i);
+		
+		if ((runs[element] == 0) && (runs[!element] > 0)) {
+			edge_counts[element] += 1;
+		}
+		
+		one_count += element;
+		runs[element] += 1;
+		runs[!element] = 0;
+		
+		if (runs[element] > longest_runs[element]) {
+			longest_runs[element] = runs[element];
+		}
+	}
+	
+	if ((statistics.bit_count != bit_count) || (statistics.one_count != one_count)) {
+		fuzz_fail("window statistics counts for %zu bits", bit_count);
+	}
+	
+	if ((statistics.rising_edge_count != edge_counts[1]) || (statistics.falling_edge_count != edge_counts[0])) {
+		fuzz_fail("window edge counts %zu/%zu, expected %zu/%zu for %zu bits",
+				  statistics.rising_edge_count, statistics.falling_edge_count, edge_counts[1], edge_counts[0], bit_count);
+	}
+	
+	if ((statistics.longest_one_run != longest_runs[1]) || (statistics.longest_zero_run != longest_runs[0])) {
+		fuzz_fail("window runs %zu/%zu, expected %zu/%zu for %zu bits",
+				  statistics.longest_one_run, statistics.longest_zero_run, longest_runs[1], longest_runs[0], bit_count);
+	}
+}
+#endif
+
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+static void
+compare_snapshot(jx_bit_ring_buffer_snapshot *snapshot, bool *window, size_t used_bit_count)
+{
+	if (jx_bit_ring_buffer_snapshot_get_used_bit_count(snapshot) != used_bit_count) {
+		fuzz_fail("snapshot used bit count");
+	}
+	
+	size_t popcount = 0;
+	
+	for (size_t i = 0; i < used_bit_count; i += 1) {
+		if (jx_bit_ring_buffer_snapshot_get(snapshot, i) != window[i]) {
+			fuzz_fail("snapshot bit %zu of %zu", i, used_bit_count);
+		}
+		
+		popcount += window[i];
+	}
+	
+	if (jx_bit_ring_buffer_snapshot_get(snapshot, used_bit_count)) {
+		fuzz_fail("snapshot bit past the end of %zu", used_bit_count);
+	}
+	
+	if (jx_bit_ring_buffer_snapshot_population_count(snapshot) != popcount) {
+		fuzz_fail("snapshot popcount %zu, expected %zu", jx_bit_ring_buffer_snapshot_population_count(snapshot), popcount);
+	}
+	
+	size_t found_index;
+	const bool found = jx_bit_ring_buffer_snapshot_find_next(snapshot, true, 0, &found_index);
+	
+	size_t expected_index = 0;
+	while ((expected_index < used_bit_count) && !window[expected_index]) {
+		expected_index += 1;
+	}
+	
+	if ((found != (expected_index < used_bit_count)) || (found && (found_index != expected_index))) {
+		fuzz_fail("snapshot find_next");
+	}
+}
+
+/* Take a snapshot, keep writing, and check that the snapshot doesn’t change. */
+static void
+fuzz_snapshot(fuzz_input *input, jx_bit_ring_buffer *buf, ring_model *model)
+{
+	bool *window = calloc(model->used_bit_count + 1, sizeof(bool));
+	for (size_t i = 0; i < model->used_bit_count; i += 1) {
+		window[i] = ring_model_get(model, i);
+	}
+	
+	jx_bit_ring_buffer_snapshot *snapshot = jx_bit_ring_buffer_snapshot_new(buf);
+	compare_snapshot(snapshot, window, model->used_bit_count);
+	
+	const size_t write_count = fuzz_input_next_byte(input) * 4;
+	const uint8_t pattern = fuzz_input_next_byte(input);
+	
+	for (size_t i = 0; i < write_count; i += 1) {
+		const bool element = (pattern >> (i % 8)) & 1;
+		jx_bit_ring_buffer_add_with_overwrite(buf, element);
+		ring_model_add_with_overwrite(model, element);
+	}
+	
+	compare_snapshot(snapshot, window, jx_bit_ring_buffer_snapshot_get_used_bit_count(snapshot));
+	
+	jx_bit_ring_buffer_snapshot_free(snapshot);
+	free(window);
+}
+
+/* Snapshots that stay alive across the operations that follow,
+ * each with a copy of the window of the model it froze. */
+#define FUZZ_SNAPSHOT_SLOT_COUNT	4
+
+typedef struct fuzz_snapshot_slot {
+	jx_bit_ring_buffer_snapshot *snapshot;
+	bool   *window;
+} fuzz_snapshot_slot;
+
+typedef struct fuzz_snapshot_iteration {
+	bool   *window;
+	size_t  visited_count;
+	size_t  stop_index;
+} fuzz_snapshot_iteration;
+
+static bool
+fuzz_visit_snapshot_bit(void *context, size_t index, bool element)
+{
+	fuzz_snapshot_iteration *iteration = context;
+	
+	if ((index != iteration->visited_count) || (element != iteration->window[index])) {
+		fuzz_fail("snapshot iteration at %zu", index);
+	}
+	
+	iteration->visited_count += 1;
+	
+	return (index < iteration->stop_index);
+}
+
+static size_t
+fuzz_snapshot_slots_live_count(fuzz_snapshot_slot *slots)
+{
+	size_t live_count = 0;
+	
+	for (size_t i = 0; i < FUZZ_SNAPSHOT_SLOT_COUNT; i += 1) {
+		live_count += (slots[i].snapshot != NULL);
+	}
+	
+	return live_count;
+}
+
+static void
+fuzz_snapshot_slot_free(fuzz_snapshot_slot *slot)
+{
+	if (slot->snapshot == NULL) {
+		return;
+	}
+	
+	compare_snapshot(slot->snapshot, slot->window, jx_bit_ring_buffer_snapshot_get_used_bit_count(slot->snapshot));
+	
+	jx_bit_ring_buffer_snapshot_free(slot->snapshot);
+	free(slot->window);
+	
+	slot->snapshot = NULL;
+	slot->window = NULL;
+}
+
+static void
+fuzz_snapshot_slot_take(fuzz_snapshot_slot *slot, jx_bit_ring_buffer *buf, ring_model *model)
+{
+	fuzz_snapshot_slot_free(slot);
+	
+	slot->window = calloc(model->used_bit_count + 1, sizeof(bool));
+	for (size_t i = 0; i < model->used_bit_count; i += 1) {
+		slot->window[i] = ring_model_get(model, i);
+	}
+	
+	slot->snapshot = jx_bit_ring_buffer_snapshot_new(buf);
+	if (slot->snapshot == NULL) {
+		fuzz_fail("snapshot result");
+	}
+}
+
+/* Read a live snapshot every way there is, long after the buffer moved on. */
+static void
+fuzz_snapshot_slot_read(fuzz_input *input, fuzz_snapshot_slot *slot)
+{
+	if (slot->snapshot == NULL) {
+		return;
+	}
+	
+	const size_t used_bit_count = jx_bit_ring_buffer_snapshot_get_used_bit_count(slot->snapshot);
+	
+	compare_snapshot(slot->snapshot, slot->window, used_bit_count);
+	
+	// Search from anywhere, including past the end.
+	const size_t start_index = fuzz_input_next_size(input) % (used_bit_count + 2);
+	const bool element = (fuzz_input_next_byte(input) & 1) != 0;
+	
+	size_t expected_index = start_index;
+	while ((expected_index < used_bit_count) && (slot->window[expected_index] != element)) {
+		expected_index += 1;
+	}
+	
+	size_t found_index;
+	const bool found = jx_bit_ring_buffer_snapshot_find_next(slot->snapshot, element, start_index, &found_index);
+	
+	if ((found != (expected_index < used_bit_count)) || (found && (found_index != expected_index))) {
+		fuzz_fail("snapshot find_next of %d from %zu", element, start_index);
+	}
+	
+	// Iterate, stopping early if the input says so.
+	fuzz_snapshot_iteration iteration = {
+		.window = slot->window,
+		.visited_count = 0,
+		.stop_index = fuzz_input_next_size(input) % (used_bit_count + 1),
+	};
+	jx_bit_ring_buffer_snapshot_iterate(slot->snapshot, fuzz_visit_snapshot_bit, &iteration);
+	
+	const size_t expected_count = (iteration.stop_index < used_bit_count) ? (iteration.stop_index + 1) : used_bit_count;
+	if (iteration.visited_count != expected_count) {
+		fuzz_fail("snapshot iteration visited %zu bits, expected %zu", iteration.visited_count, expected_count);
+	}
+}
+#endif
+
+
+/*-----------------------------------------------------------------------
+ * Bitset model
+ */
+
+static void
+compare_bitset(jx_bitset *set, bool *model)
+{
+	const size_t bit_count = jx_bitset_get_bit_count(set);
+	size_t popcount = 0;
+	
+	for (size_t i = 0; i < bit_count; i += 1) {
+		if (jx_bitset_get(set, i) != model[i]) {
+			fuzz_fail("bitset bit %zu of %zu", i, bit_count);
+		}
+		
+		popcount += model[i];
+	}
+	
+	if (jx_bitset_popcount(set) != popcount) {
+		fuzz_fail("bitset popcount %zu, expected %zu for bit count %zu", jx_bitset_popcount(set), popcount, bit_count);
+	}
+}
+
+static void
+fuzz_bitset_shift(jx_bitset *set, jx_bitset *reference, bool *model)
+{
+	const size_t bit_count = jx_bitset_get_bit_count(set);
+	
+#if JX_BITSET_INVERT_BIT_ORDER
+	jx_bitset_shift_all_bits_forward(set);
+#else
+	jx_bitset_shift_all_bits_forward_slowest(set);
+#endif
+	jx_bitset_shift_all_bits_forward_slowest(reference);
+	
+	memmove(&model[1], &model[0], (bit_count - 1) * sizeof(bool));
+	model[0] = false;
+	
+	compare_bitset(reference, model);
+	
+	// Compare the fast path against the reference, not just the model,
+	// so that bits beyond `bit_count` get caught, too.
+	if (memcmp(set->bits, reference->bits, set->byte_count) != 0) {
+		fuzz_fail("shift differs from the slowest reference for bit count %zu", bit_count);
+	}
+}
+
+static void
+fuzz_bitset_copy_bits(fuzz_input *input, jx_bitset *set, bool *model)
+{
+	const size_t bit_count = jx_bitset_get_bit_count(set);
+	
+	const size_t src_offset = fuzz_input_next_size(input) % bit_count;
+	const size_t dst_offset = fuzz_input_next_size(input) % (bit_count + 1);
+	const size_t max_count = bit_count - src_offset;
+	const size_t count = fuzz_input_next_size(input) % (max_count + 1);
+	
+	jx_bitset dst;
+	jx_bitset_init(&dst, dst_offset + count + (fuzz_input_next_byte(input) % 70));
+	
+	const size_t dst_bit_count = jx_bitset_get_bit_count(&dst);
+	bool *dst_model = calloc(dst_bit_count + 1, sizeof(bool));
+	
+	// Prefill, so that bits outside of the copied range must be preserved.
+	for (size_t i = 0; i < dst_bit_count; i += 3) {
+		jx_bitset_set(&dst, i, true);
+		dst_model[i] = true;
+	}
+	
+	jx_bitset_copy_bits(&dst, dst_offset, set, src_offset, count);
+	memcpy(&dst_model[dst_offset], &model[src_offset], count * sizeof(bool));
+	
+	compare_bitset(&dst, dst_model);
+	
+	free(dst_model);
+	jx_bitset_done(&dst);
+}
+
+
+/*-----------------------------------------------------------------------
+ * Large bitset: the parallel variants and the kernels
+ */
+
+#if JX_BITSET_USE_THREAD_POOL
+/* Just past the size from which the parallel variants split the set between threads,
+ * and not a whole number of units, so that the last chunk ends within one. */
+#define FUZZ_LARGE_BIT_COUNT	(JX_BITSET_PARALLEL_MIN_BYTE_COUNT * JX_BITSET_BITS_PER_BYTE + 77)
+
+/* Each operation on the large set touches all of it, so only a few run per input. */
+#define FUZZ_MAX_LARGE_OP_COUNT	4
+
+#define FUZZ_THREAD_COUNT	3
+
+#define FUZZ_MAX_KERNEL_COUNT	8
+
+typedef struct fuzz_large_bitset {
+	jx_bitset   set;
+	/* Changed by the serial variants only */
+	jx_bitset   reference;
+	bool       *model;
+	size_t      op_count;
+} fuzz_large_bitset;
+
+/* Shared by all inputs: a pool keeps no state from one run to the next. */
+static jx_thread_pool *
+fuzz_thread_pool(void)
+{
+	static jx_thread_pool *pool = NULL;
+	
+	if (pool == NULL) {
+		pool = jx_thread_pool_new(FUZZ_THREAD_COUNT);
+	}
+	
+	return pool;
+}
+
+/* Return whether the input may still run an operation on the large set.
+ * The first one fills it with random bits of a density the input picks. */
+static bool
+fuzz_large_bitset_begin_op(fuzz_input *input, fuzz_large_bitset *large)
+{
+	if (large->op_count >= FUZZ_MAX_LARGE_OP_COUNT) {
+		return false;
+	}
+	
+	if (large->model == NULL) {
+		jx_bitset_init(&large->set, FUZZ_LARGE_BIT_COUNT);
+		jx_bitset_init(&large->reference, FUZZ_LARGE_BIT_COUNT);
+		large->model = calloc(FUZZ_LARGE_BIT_COUNT, sizeof(bool));
+		
+		const uint8_t density = fuzz_input_next_byte(input);
+		uint64_t state = ((uint64_t)fuzz_input_next_byte(input) << 32) | 1;
+		
+		for (size_t i = 0; i < FUZZ_LARGE_BIT_COUNT; i += 1) {
+			const bool element = (uint8_t)xorshift64(&state) < density;
+			jx_bitset_set(&large->set, i, element);
+			jx_bitset_set(&large->reference, i, element);
+			large->model[i] = element;
+		}
+	}
+	
+	large->op_count += 1;
+	
+	return true;
+}
+
+static void
+fuzz_large_bitset_done(fuzz_large_bitset *large)
+{
+	if (large->model == NULL) {
+		return;
+	}
+	
+	free(large->model);
+	jx_bitset_done(&large->reference);
+	jx_bitset_done(&large->set);
+}
+
+static void
+compare_large_bitset(fuzz_large_bitset *large)
+{
+	compare_bitset(&large->set, large->model);
+	
+	size_t popcount = 0;
+	for (size_t i = 0; i < FUZZ_LARGE_BIT_COUNT; i += 1) {
+		popcount += large->model[i];
+	}
+	
+	if (jx_bitset_popcount_parallel(&large->set, fuzz_thread_pool()) != popcount) {
+		fuzz_fail("parallel popcount %zu, expected %zu",
+				  jx_bitset_popcount_parallel(&large->set, fuzz_thread_pool()), popcount);
+	}
+	
+	// Bits beyond the end of the set and at the chunk boundaries have to match the serial variants, too.
+	if (memcmp(large->set.bits, large->reference.bits, large->set.byte_count) != 0) {
+		fuzz_fail("parallel variant differs from the serial one");
+	}
+}
+
+static void
+fuzz_large_bitset_set(fuzz_input *input, fuzz_large_bitset *large)
+{
+	const size_t count = fuzz_input_next_byte(input) % 32;
+	
+	for (size_t i = 0; i < count; i += 1) {
+		const size_t index = ((fuzz_input_next_size(input) << 8) | fuzz_input_next_byte(input)) % FUZZ_LARGE_BIT_COUNT;
+		const bool element = (index & 1) == 0;
+		
+		jx_bitset_set(&large->set, index, element);
+		jx_bitset_set(&large->reference, index, element);
+		large->model[index] = element;
+	}
+}
+
+#if JX_BITSET_INVERT_BIT_ORDER
+static void
+fuzz_large_bitset_set_all_to_true(fuzz_large_bitset *large)
+{
+	jx_bitset_set_all_to_true_parallel(&large->set, fuzz_thread_pool());
+	jx_bitset_set_all_to_true(&large->reference);
+	
+	for (size_t i = 0; i < FUZZ_LARGE_BIT_COUNT; i += 1) {
+		large->model[i] = true;
+	}
+}
+
+static void
+fuzz_large_bitset_shift(fuzz_large_bitset *large)
+{
+	jx_bitset_shift_all_bits_forward_parallel(&large->set, fuzz_thread_pool());
+	jx_bitset_shift_all_bits_forward_slowest(&large->reference);
+	
+	memmove(&large->model[1], &large->model[0], (FUZZ_LARGE_BIT_COUNT - 1) * sizeof(bool));
+	large->model[0] = false;
+}
+#endif
+
+/* Run every kernel variant this CPU supports on a range of units of the large set:
+ * popcounts against the model, shifts against the baseline. */
+static void
+fuzz_kernels(fuzz_input *input, fuzz_large_bitset *large)
+{
+	const size_t unit_bit_count = sizeof(size_t) * JX_BITSET_BITS_PER_BYTE;
+	const size_t max_unit_count = FUZZ_LARGE_BIT_COUNT / unit_bit_count;
+	
+	const size_t first_unit = fuzz_input_next_size(input) % max_unit_count;
+	const size_t unit_count = fuzz_input_next_size(input) % (max_unit_count - first_unit + 1);
+	const size_t prev_overflow = fuzz_input_next_byte(input) & 1;
+	
+	const size_t *units = (const size_t *)large->set.bits + first_unit;
+	
+	size_t popcount = 0;
+	for (size_t i = first_unit * unit_bit_count; i < (first_unit + unit_count) * unit_bit_count; i += 1) {
+		popcount += large->model[i];
+	}
+	
+	size_t *expected = malloc((unit_count + 1) * sizeof(size_t));
+	size_t *shifted = malloc((unit_count + 1) * sizeof(size_t));
+	
+	memcpy(expected, units, unit_count * sizeof(size_t));
+	const size_t expected_overflow = jx_bitset_kernels_baseline.shift_units_forward(expected, unit_count, prev_overflow);
+	
+	const jx_bitset_kernels *kernels[FUZZ_MAX_KERNEL_COUNT];
+	const size_t kernel_count = jx_bitset_get_supported_kernels(kernels, FUZZ_MAX_KERNEL_COUNT);
+	
+	for (size_t k = 0; k < kernel_count; k += 1) {
+		if (kernels[k]->popcount_units(units, unit_count) != popcount) {
+			fuzz_fail("%s popcount of %zu units at %zu", kernels[k]->name, unit_count, first_unit);
+		}
+		
+		memcpy(shifted, units, unit_count * sizeof(size_t));
+		const size_t overflow = kernels[k]->shift_units_forward(shifted, unit_count, prev_overflow);
+		
+		if ((overflow != expected_overflow) || (memcmp(shifted, expected, unit_count * sizeof(size_t)) != 0)) {
+			fuzz_fail("%s shift of %zu units at %zu", kernels[k]->name, unit_count, first_unit);
+		}
+	}
+	
+	free(shifted);
+	free(expected);
+}
+#endif
+
+
+/*-----------------------------------------------------------------------
+ * Operation stream
+ */
+
+enum {
+	FUZZ_OP_RING_ADD,
+	FUZZ_OP_RING_ADD_WITH_OVERWRITE,
+	FUZZ_OP_RING_POP,
+	FUZZ_OP_RING_PEEK,
+	FUZZ_OP_RING_ADD_WITH_GROWTH,
+	FUZZ_OP_RING_RESERVE,
+	FUZZ_OP_RING_SHRINK_TO_FIT,
+	FUZZ_OP_RING_SNAPSHOT,
+	FUZZ_OP_RING_STATISTICS,
+	FUZZ_OP_BITSET_SET,
+	FUZZ_OP_BITSET_SHIFT,
+	FUZZ_OP_BITSET_SET_ALL,
+	FUZZ_OP_BITSET_CLEAR,
+	FUZZ_OP_BITSET_COPY_BITS,
+	FUZZ_OP_RING_ADD_BURST,
+	FUZZ_OP_RING_SNAPSHOT_TAKE,
+	FUZZ_OP_RING_SNAPSHOT_READ,
+	FUZZ_OP_RING_SNAPSHOT_FREE,
+	FUZZ_OP_LARGE_BITSET_SET,
+	FUZZ_OP_LARGE_BITSET_POPCOUNT,
+	FUZZ_OP_LARGE_BITSET_SET_ALL,
+	FUZZ_OP_LARGE_BITSET_SHIFT,
+	FUZZ_OP_KERNELS,
+	FUZZ_OP_COUNT
+};
+
+int
+LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int
+LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	fuzz_input input = {
+		.data = data,
+		.size = size,
+		.offset = 0,
+	};
+	
+	const size_t bit_count = fuzz_bit_counts[fuzz_input_next_byte(&input) % FUZZ_BIT_COUNT_COUNT];
+	
+	jx_bit_ring_buffer buf;
+	jx_bit_ring_buffer_init(&buf, bit_count);
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+	jx_bit_ring_buffer_set_tracks_edges(&buf, true);
+#endif
+	ring_model ring;
+	ring_model_init(&ring, bit_count);
+	
+	jx_bitset set;
+	jx_bitset reference;
+	jx_bitset_init(&set, bit_count);
+	jx_bitset_init(&reference, bit_count);
+	bool *model = calloc(bit_count, sizeof(bool));
+	
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	fuzz_snapshot_slot snapshot_slots[FUZZ_SNAPSHOT_SLOT_COUNT] = {{0}};
+#endif
+#if JX_BITSET_USE_THREAD_POOL
+	fuzz_large_bitset large = {0};
+#endif
+	
+	fuzz_step = 0;
+	
+	while (!fuzz_input_is_empty(&input)) {
+		const uint8_t op = fuzz_input_next_byte(&input);
+		const bool element = (op & 0x80) != 0;
+		
+		// Live snapshots keep the storage of the ring from being replaced.
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+		const bool can_resize = (fuzz_snapshot_slots_live_count(snapshot_slots) == 0);
+#else
+		const bool can_resize = true;
+#endif
+		
+		switch ((op & 0x7f) % FUZZ_OP_COUNT) {
+			case FUZZ_OP_RING_ADD:
+				if (jx_bit_ring_buffer_add(&buf, element) != ring_model_add(&ring, element)) {
+					fuzz_fail("add result");
+				}
+				break;
+				
+			case FUZZ_OP_RING_ADD_WITH_OVERWRITE:
+				jx_bit_ring_buffer_add_with_overwrite(&buf, element);
+				ring_model_add_with_overwrite(&ring, element);
+				break;
+				
+			case FUZZ_OP_RING_POP:
+			case FUZZ_OP_RING_PEEK: {
+				const bool is_pop = (((op & 0x7f) % FUZZ_OP_COUNT) == FUZZ_OP_RING_POP);
+				const int expected = is_pop ? ring_model_pop(&ring)
+				: ((ring.used_bit_count > 0) ? ring_model_get(&ring, 0) : -1);
+				const bool *result = is_pop ? jx_bit_ring_buffer_pop(&buf) : jx_bit_ring_buffer_peek(&buf);
+				
+				if ((result == NULL) != (expected < 0) || ((result != NULL) && (*result != expected))) {
+					fuzz_fail(is_pop ? "pop result" : "peek result");
+				}
+				break;
+			}
+				
+			case FUZZ_OP_RING_ADD_WITH_GROWTH:
+				if (ring.bit_count >= FUZZ_MAX_BIT_COUNT) {
+					break;
+				}
+				if (ring.used_bit_count == ring.bit_count) {
+					if (!can_resize) {
+						if (jx_bit_ring_buffer_add_with_growth(&buf, element)) {
+							fuzz_fail("add with growth result with live snapshots");
+						}
+						break;
+					}
+					ring_model_resize(&ring, ring.bit_count * 2);
+				}
+				if (!jx_bit_ring_buffer_add_with_growth(&buf, element) || !ring_model_add(&ring, element)) {
+					fuzz_fail("add with growth result");
+				}
+				break;
+				
+			case FUZZ_OP_RING_RESERVE: {
+				const size_t new_bit_count = ring.bit_count + fuzz_input_next_byte(&input);
+				if (new_bit_count > FUZZ_MAX_BIT_COUNT) {
+					break;
+				}
+				const bool needs_resize = (new_bit_count > ring.bit_count);
+				if (jx_bit_ring_buffer_reserve(&buf, new_bit_count) != (can_resize || !needs_resize)) {
+					fuzz_fail("reserve result");
+				}
+				if (needs_resize && can_resize) {
+					ring_model_resize(&ring, new_bit_count);
+				}
+				break;
+			}
+				
+			case FUZZ_OP_RING_SHRINK_TO_FIT: {
+				const size_t new_bit_count = (ring.used_bit_count > 0) ? ring.used_bit_count : 1;
+				const bool needs_resize = (new_bit_count != ring.bit_count);
+				if (jx_bit_ring_buffer_shrink_to_fit(&buf) != (can_resize || !needs_resize)) {
+					fuzz_fail("shrink to fit result");
+				}
+				if (needs_resize && can_resize) {
+					ring_model_resize(&ring, new_bit_count);
+				}
+				break;
+			}
+				
+			case FUZZ_OP_RING_SNAPSHOT:
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+				fuzz_snapshot(&input, &buf, &ring);
+#endif
+				break;
+				
+			case FUZZ_OP_RING_STATISTICS:
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+				fuzz_window_statistics(&buf, &ring, fuzz_input_next_size(&input) % (ring.used_bit_count + 2));
+#endif
+				break;
+				
+			case FUZZ_OP_BITSET_SET: {
+				const size_t index = fuzz_input_next_size(&input) % bit_count;
+				jx_bitset_set(&set, index, element);
+				jx_bitset_set(&reference, index, element);
+				model[index] = element;
+				break;
+			}
+				
+			case FUZZ_OP_BITSET_SHIFT:
+				fuzz_bitset_shift(&set, &reference, model);
+				break;
+				
+			case FUZZ_OP_BITSET_SET_ALL:
+#if JX_BITSET_INVERT_BIT_ORDER
+				jx_bitset_set_all(&set, element);
+				jx_bitset_set_all(&reference, element);
+				for (size_t i = 0; i < bit_count; i += 1) {
+					model[i] = element;
+				}
+#endif
+				break;
+				
+			case FUZZ_OP_BITSET_CLEAR:
+				jx_bitset_clear(&set);
+				jx_bitset_clear(&reference);
+				memset(model, 0, bit_count * sizeof(bool));
+				break;
+				
+			case FUZZ_OP_BITSET_COPY_BITS:
+				fuzz_bitset_copy_bits(&input, &set, model);
+				break;
+				
+			case FUZZ_OP_RING_ADD_BURST: {
+				// Enough writes to reach every block of the largest rings, for the snapshots still alive.
+				const size_t write_count = fuzz_input_next_byte(&input) * 16;
+				const uint8_t pattern = fuzz_input_next_byte(&input);
+				
+				for (size_t i = 0; i < write_count; i += 1) {
+					const bool burst_element = (pattern >> (i % 8)) & 1;
+					jx_bit_ring_buffer_add_with_overwrite(&buf, burst_element);
+					ring_model_add_with_overwrite(&ring, burst_element);
+				}
+				break;
+			}
+				
+			case FUZZ_OP_RING_SNAPSHOT_TAKE:
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+				fuzz_snapshot_slot_take(&snapshot_slots[op % FUZZ_SNAPSHOT_SLOT_COUNT], &buf, &ring);
+#endif
+				break;
+				
+			case FUZZ_OP_RING_SNAPSHOT_READ:
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+				fuzz_snapshot_slot_read(&input, &snapshot_slots[op % FUZZ_SNAPSHOT_SLOT_COUNT]);
+#endif
+				break;
+				
+			case FUZZ_OP_RING_SNAPSHOT_FREE:
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+				fuzz_snapshot_slot_free(&snapshot_slots[op % FUZZ_SNAPSHOT_SLOT_COUNT]);
+#endif
+				break;
+				
+#if JX_BITSET_USE_THREAD_POOL
+			case FUZZ_OP_LARGE_BITSET_SET:
+				if (fuzz_large_bitset_begin_op(&input, &large)) {
+					fuzz_large_bitset_set(&input, &large);
+					compare_large_bitset(&large);
+				}
+				break;
+				
+			case FUZZ_OP_LARGE_BITSET_POPCOUNT:
+				if (fuzz_large_bitset_begin_op(&input, &large)) {
+					compare_large_bitset(&large);
+				}
+				break;
+				
+			case FUZZ_OP_LARGE_BITSET_SET_ALL:
+#if JX_BITSET_INVERT_BIT_ORDER
+				if (fuzz_large_bitset_begin_op(&input, &large)) {
+					fuzz_large_bitset_set_all_to_true(&large);
+					compare_large_bitset(&large);
+				}
+#endif
+				break;
+				
+			case FUZZ_OP_LARGE_BITSET_SHIFT:
+#if JX_BITSET_INVERT_BIT_ORDER
+				if (fuzz_large_bitset_begin_op(&input, &large)) {
+					fuzz_large_bitset_shift(&large);
+					compare_large_bitset(&large);
+				}
+#endif
+				break;
+				
+			case FUZZ_OP_KERNELS:
+				if (fuzz_large_bitset_begin_op(&input, &large)) {
+					fuzz_kernels(&input, &large);
+				}
+				break;
+#endif
+		}
+		
+		compare_ring(&buf, &ring);
+		compare_bitset(&set, model);
+		
+		fuzz_step += 1;
+	}
+	
+#if JX_BITSET_USE_THREAD_POOL
+	fuzz_large_bitset_done(&large);
+#endif
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	for (size_t i = 0; i < FUZZ_SNAPSHOT_SLOT_COUNT; i += 1) {
+		fuzz_snapshot_slot_free(&snapshot_slots[i]);
+	}
+#endif
+	
+	free(model);
+	jx_bitset_done(&reference);
+	jx_bitset_done(&set);
+	ring_model_done(&ring);
+	jx_bit_ring_buffer_done(&buf);
+	
+	return 0;
+}
+
+
+#if !JX_FUZZ_USE_LIBFUZZER
+
+int
+main(int argc, const char *argv[])
+{
+	const size_t iterations = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 10) : 2000;
+	uint64_t state = (argc > 2) ? strtoull(argv[2], NULL, 10) : 0x2545F4914F6CDD1Dull;
+	if (state == 0) {
+		state = 1;
+	}
+	
+	uint8_t data[1024];
+	
+	for (size_t i = 0; i < iterations; i += 1) {
+		const size_t size = 1 + xorshift64(&state) % sizeof(data);
+		
+		for (size_t j = 0; j < size; j += 1) {
+			data[j] = (uint8_t)xorshift64(&state);
+		}
+		
+		LLVMFuzzerTestOneInput(data, size);
+	}
+	
+	printf("%zu random operation streams passed.\n", iterations);
+	
+	return EXIT_SUCCESS;
+}
+
+#endif
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
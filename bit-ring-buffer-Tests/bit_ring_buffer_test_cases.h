@@ -0,0 +1,1141 @@
+//
+//  bit_ring_buffer_test_cases.h
+//  bit-ring-buffer-Tests
+//
+//  Created by agent on 18.10.26, from the tests in bit_ring_buffer_Tests.m.
+//  Copyright © 2017 Jan. All rights reserved.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  The test cases, shared by the XCTest bundle (bit_ring_buffer_Tests.m)
+//  and the plain C test runner (bit_ring_buffer_tests.c).
+//  The including file provides `id` and the XCTAssert… macros.
+//
+
+#ifndef BIT_RING_BUFFER_TEST_CASES_H
+#define BIT_RING_BUFFER_TEST_CASES_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "bitset-kernels.h"
+#include "bit-ring-buffer.h"
+#include "bit-ring-buffer-snapshot.h"
+#include "bit-ring-buffer-statistics.h"
+#include "instrumentation.h"
+
+
+static void
+test_bitset_with_bit_count(id self, jx_bitset *set) {
+	size_t bit_count = jx_bitset_get_bit_count(set);
+	
+	for (size_t i = 0; i < bit_count; i += 1) {
+		jx_bitset_set(set, i, true);
+		XCTAssertTrue(jx_bitset_get(set, i), "Unexpected value for bit %zu", i);
+		
+		XCTAssertEqual(jx_bitset_popcount(set), (i + 1));
+	}
+	
+	const size_t max_popcount = bit_count;
+
+	for (size_t i = 0; i < bit_count; i += 1) {
+		jx_bitset_set(set, i, false);
+		XCTAssertFalse(jx_bitset_get(set, i), "Unexpected value for bit %zu", i);
+		
+		XCTAssertEqual(jx_bitset_popcount(set), (max_popcount - i - 1),
+					   "Unexpected number of bits set to true for bit count %zu.", bit_count);
+	}
+	
+#if JX_BITSET_INVERT_BIT_ORDER
+	jx_bitset_set_all_to_true(set);
+	XCTAssertEqual(jx_bitset_popcount(set), bit_count,
+				   "Unexpected number of bits after setting all to true for bit count %zu.", bit_count);
+	
+	jx_bitset_shift_all_bits_forward(set);
+	XCTAssertEqual(jx_bitset_popcount(set), (bit_count - 1),
+				   "Unexpected number of bits set to true after shift for bit count %zu.", bit_count);
+#endif
+}
+
+static void
+test_bitset_with_bit_count_alternating_values(id self, jx_bitset *set) {
+	size_t bit_count = jx_bitset_get_bit_count(set);
+	
+	for (size_t i = 0; i < bit_count; i += 2) {
+		jx_bitset_set(set, i, true);
+		XCTAssertTrue(jx_bitset_get(set, i), "Unexpected value for bit %zu", i);
+		
+		XCTAssertEqual(jx_bitset_popcount(set), (i/2 + 1));
+	}
+	
+	const size_t max_alternating_popcount = bit_count/2 + bit_count % 2;
+
+	for (size_t i = 0; i < bit_count; i += 2) {
+		jx_bitset_set(set, i, false);
+		XCTAssertFalse(jx_bitset_get(set, i), "Unexpected value for bit %zu", i);
+		
+		XCTAssertEqual(jx_bitset_popcount(set), (max_alternating_popcount - i/2 - 1),
+					   "Unexpected number of bits set to true for bit count %zu.", bit_count);
+	}
+}
+
+static void
+test_stack_bitset_of_size(id self, size_t bit_count)
+{
+	jx_bitset set;
+	jx_bitset_init(&set, bit_count);
+	
+	test_bitset_with_bit_count(self, &set);
+	jx_bitset_clear(&set);
+	test_bitset_with_bit_count_alternating_values(self, &set);
+	
+	jx_bitset_done(&set);
+}
+
+static void
+test_heap_bitset_of_size(id self, size_t bit_count)
+{
+	jx_bitset *set = jx_bitset_new(bit_count);
+	
+	test_bitset_with_bit_count(self, set);
+	jx_bitset_clear(set);
+	test_bitset_with_bit_count_alternating_values(self, set);
+
+	jx_bitset_free(set);
+}
+
+static void
+test_bitset_of_size(id self, size_t bit_count)
+{
+	test_stack_bitset_of_size(self, bit_count);
+	test_heap_bitset_of_size(self, bit_count);
+}
+
+static void
+test_bitset(id self)
+{
+	test_bitset_of_size(self, 1);
+	test_bitset_of_size(self, 2);
+	test_bitset_of_size(self, 3);
+	test_bitset_of_size(self, 4);
+	test_bitset_of_size(self, 5);
+	test_bitset_of_size(self, 6);
+	test_bitset_of_size(self, 7);
+	test_bitset_of_size(self, 8);
+	test_bitset_of_size(self, 9);
+	test_bitset_of_size(self, 10);
+	test_bitset_of_size(self, 11);
+	test_bitset_of_size(self, 12);
+	test_bitset_of_size(self, 13);
+	test_bitset_of_size(self, 14);
+	test_bitset_of_size(self, 15);
+	test_bitset_of_size(self, 16);
+	test_bitset_of_size(self, 31);
+	test_bitset_of_size(self, 32);
+	test_bitset_of_size(self, 63);
+	test_bitset_of_size(self, 64);
+	test_bitset_of_size(self, 65535);
+	test_bitset_of_size(self, 65536);
+	test_bitset_of_size(self, 65537);
+}
+
+
+static void
+test_bitset_kernels_with_unit_count(id self, const jx_bitset_kernels *kernels, size_t unit_count)
+{
+	size_t *expected = calloc(unit_count + 1, sizeof(size_t));
+	size_t *units = calloc(unit_count + 1, sizeof(size_t));
+	
+	size_t state = 0x9E3779B97F4A7C15u;
+	for (size_t i = 0; i < unit_count; i += 1) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		expected[i] = state;
+		units[i] = state;
+	}
+	
+	XCTAssertEqual(kernels->popcount_units(units, unit_count),
+				   jx_bitset_kernels_baseline.popcount_units(expected, unit_count),
+				   "Unexpected %s popcount for %zu units.", kernels->name, unit_count);
+	
+	for (size_t prev_overflow = 0; prev_overflow <= 1; prev_overflow += 1) {
+		const size_t expected_overflow = jx_bitset_kernels_baseline.shift_units_forward(expected, unit_count, prev_overflow);
+		const size_t overflow = kernels->shift_units_forward(units, unit_count, prev_overflow);
+		
+		XCTAssertEqual(overflow, expected_overflow,
+					   "Unexpected %s shift overflow for %zu units.", kernels->name, unit_count);
+		XCTAssertEqual(memcmp(units, expected, unit_count * sizeof(size_t)), 0,
+					   "Unexpected %s shift for %zu units.", kernels->name, unit_count);
+	}
+	
+	free(units);
+	free(expected);
+}
+
+static void
+test_bitset_kernels(id self)
+{
+	const jx_bitset_kernels *supported[8];
+	const size_t supported_count = jx_bitset_get_supported_kernels(supported, 8);
+	
+	XCTAssertTrue(supported_count >= 1, "The baseline kernels should always be supported.");
+	XCTAssertTrue(jx_bitset_get_kernels() == supported[0],
+				  "The fastest supported kernels should be selected.");
+	
+	for (size_t k = 0; k < supported_count; k += 1) {
+		// Every vector length and remainder, then something larger.
+		for (size_t unit_count = 0; unit_count <= 40; unit_count += 1) {
+			test_bitset_kernels_with_unit_count(self, supported[k], unit_count);
+		}
+		test_bitset_kernels_with_unit_count(self, supported[k], 4099);
+	}
+}
+
+#if JX_BITSET_USE_THREAD_POOL
+static void
+fill_bitsets_with_pattern(jx_bitset *a, jx_bitset *b)
+{
+	size_t bit_count = jx_bitset_get_bit_count(a);
+	
+	for (size_t i = 0; i < bit_count; i += 1) {
+		// Irregular enough to catch bits lost at chunk boundaries.
+		const bool val = ((i * 2654435761u) >> 7) & 1;
+		jx_bitset_set(a, i, val);
+		jx_bitset_set(b, i, val);
+	}
+}
+
+static void
+test_parallel_bitset_of_size(id self, jx_thread_pool *pool, size_t bit_count)
+{
+	jx_bitset serial;
+	jx_bitset parallel;
+	jx_bitset_init(&serial, bit_count);
+	jx_bitset_init(&parallel, bit_count);
+	
+	fill_bitsets_with_pattern(&serial, &parallel);
+	
+	if (bit_count > JX_BITSET_INLINE_STORAGE_COUNT) {
+		XCTAssertEqual((uintptr_t)parallel.bits % JX_BITSET_CACHE_LINE_SIZE, 0,
+					   "Storage isn't cache-line-aligned for bit count %zu.", bit_count);
+	}
+	
+	XCTAssertEqual(jx_bitset_popcount_parallel(&parallel, pool), jx_bitset_popcount(&serial),
+				   "Unexpected parallel popcount for bit count %zu.", bit_count);
+	
+#if JX_BITSET_INVERT_BIT_ORDER
+	for (size_t i = 0; i < 3; i += 1) {
+		jx_bitset_shift_all_bits_forward_slowest(&serial);
+		jx_bitset_shift_all_bits_forward_parallel(&parallel, pool);
+	}
+	
+	XCTAssertEqual(memcmp(serial.bits, parallel.bits, serial.byte_count), 0,
+				   "Unexpected bits after parallel shift for bit count %zu.", bit_count);
+	
+	jx_bitset_set_all_to_true_parallel(&parallel, pool);
+	XCTAssertEqual(jx_bitset_popcount(&parallel), bit_count,
+				   "Unexpected number of bits after setting all to true in parallel for bit count %zu.", bit_count);
+#endif
+	
+	jx_bitset_done(&serial);
+	jx_bitset_done(&parallel);
+}
+
+static void
+test_bitset_parallel(id self)
+{
+	const size_t min_parallel_bit_count = JX_BITSET_PARALLEL_MIN_BYTE_COUNT * JX_BITSET_BITS_PER_BYTE;
+	
+	for (size_t thread_count = 1; thread_count <= 4; thread_count += 1) {
+		jx_thread_pool *pool = jx_thread_pool_new(thread_count);
+		XCTAssertTrue(pool != NULL, "Cannot create thread pool.");
+		
+		test_parallel_bitset_of_size(self, pool, 64);
+		test_parallel_bitset_of_size(self, pool, 65537);
+		test_parallel_bitset_of_size(self, pool, min_parallel_bit_count);
+		test_parallel_bitset_of_size(self, pool, min_parallel_bit_count + 1);
+		test_parallel_bitset_of_size(self, pool, min_parallel_bit_count + 63);
+		test_parallel_bitset_of_size(self, pool, 3 * min_parallel_bit_count + 513);
+		
+		jx_thread_pool_free(pool);
+	}
+}
+#endif
+
+
+const bool value_1 = false;
+const bool value_2 = true;
+const bool value_3 = false;
+const bool value_4 = true;
+const bool value_5 = false;
+const bool value_6 = true;
+const bool value_7 = false;
+
+void
+test_bit_ring_buffer_fill(id self, jx_bit_ring_buffer *buf)
+{
+	XCTAssertEqual(jx_bit_ring_buffer_add(buf, value_1), true,
+				   "Cannot add to ring buffer.");
+	XCTAssertEqual(jx_bit_ring_buffer_add(buf, value_2), true,
+				   "Cannot add to ring buffer.");
+	XCTAssertEqual(jx_bit_ring_buffer_add(buf, value_3), true,
+				   "Cannot add to ring buffer.");
+	XCTAssertEqual(jx_bit_ring_buffer_add(buf, value_4), true,
+				   "Cannot add to ring buffer.");
+	
+	XCTAssertEqual(jx_bit_ring_buffer_is_full(buf), true,
+				   "Ring buffer should be full.");
+}
+
+static void
+test_bit_ring_buffer_core(id self, jx_bit_ring_buffer *buf)
+{
+	XCTAssertEqual(jx_bit_ring_buffer_get_allocated_size(buf), 4,
+				   "Ring buffer should provide storage for the right number of elements.");
+	
+	XCTAssertEqual(jx_bit_ring_buffer_is_empty(buf), true,
+				   "Ring buffer should be empty.");
+	
+	test_bit_ring_buffer_fill(self, buf);
+	
+	XCTAssertNotEqual(jx_bit_ring_buffer_add(buf, value_5), true,
+					  "Shouldn't be able to add to a full ring buffer.");
+	
+	XCTAssertEqual(*jx_bit_ring_buffer_peek(buf), value_1,
+				   "Unexpected head of ring buffer (peek).");
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_1,
+				   "Unexpected head of ring buffer (pop).");
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_2,
+				   "Unexpected head of ring buffer (pop).");
+	
+	XCTAssertEqual(jx_bit_ring_buffer_add(buf, value_5), true,
+				   "Cannot add to ring buffer.");
+	XCTAssertEqual(jx_bit_ring_buffer_add(buf, value_6), true,
+				   "Cannot add to ring buffer.");
+	XCTAssertNotEqual(jx_bit_ring_buffer_add(buf, value_7), true,
+					  "Shouldn't be able to add to ring buffer.");
+	
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_3,
+				   "Unexpected head of ring buffer (pop).");
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_4,
+				   "Unexpected head of ring buffer (pop).");
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_5,
+				   "Unexpected head of ring buffer (pop).");
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_6,
+				   "Unexpected head of ring buffer (pop).");
+	XCTAssertEqual(jx_bit_ring_buffer_pop(buf), NULL,
+				   "Shouldn't be able to pop from an empty ring buffer.");
+	
+	XCTAssertEqual(jx_bit_ring_buffer_is_empty(buf), true,
+				   "Ring buffer should be empty.");
+	
+	test_bit_ring_buffer_fill(self, buf);
+	
+	XCTAssertNotEqual(jx_bit_ring_buffer_add(buf, value_2), true,
+					  "Shouldn't be able to add to a full ring buffer.");
+	
+	XCTAssertEqual(jx_bit_ring_buffer_population_count(buf), 2,
+				   "Unexpected head of ring buffer (peek).");
+
+	jx_bit_ring_buffer_add_with_overwrite(buf, value_2);
+	XCTAssertEqual(*jx_bit_ring_buffer_peek(buf), value_2,
+				   "Unexpected head of ring buffer (peek).");
+
+	XCTAssertEqual(jx_bit_ring_buffer_population_count(buf), 3,
+				   "Unexpected head of ring buffer (peek).");
+	
+	// Overwriting drops the oldest element, so the rest keep their order.
+	jx_bit_ring_buffer_add_with_overwrite(buf, value_5);
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_3,
+				   "Unexpected head of ring buffer after overwrite (pop).");
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_4,
+				   "Unexpected head of ring buffer after overwrite (pop).");
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_2,
+				   "Unexpected head of ring buffer after overwrite (pop).");
+	XCTAssertEqual(*jx_bit_ring_buffer_pop(buf), value_5,
+				   "Unexpected head of ring buffer after overwrite (pop).");
+	XCTAssertEqual(jx_bit_ring_buffer_pop(buf), NULL,
+				   "Shouldn't be able to pop from an empty ring buffer.");
+}
+
+static void
+test_stack_bit_ring_buffer(id self)
+{
+	struct jx_bit_ring_buffer buf;
+	jx_bit_ring_buffer_init(&buf, 4);
+	
+	test_bit_ring_buffer_core(self, &buf);
+	
+	jx_bit_ring_buffer_done(&buf);
+
+}
+
+static void
+test_heap_bit_ring_buffer(id self)
+{
+	struct jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(4);
+	
+	test_bit_ring_buffer_core(self, buf);
+	
+	jx_bit_ring_buffer_free(buf);
+}
+
+static void
+test_bit_ring_buffer(id self)
+{
+	test_stack_bit_ring_buffer(self);
+	test_heap_bit_ring_buffer(self);
+}
+
+static bool
+expected_bit_for_growth_test(size_t i)
+{
+	return ((i * 7) % 5) < 2;
+}
+
+static void
+test_bit_ring_buffer_window(id self, jx_bit_ring_buffer *buf, size_t first_value, size_t used_bit_count)
+{
+	XCTAssertEqual(jx_bit_ring_buffer_get_used_bit_count(buf), used_bit_count);
+	
+	for (size_t i = 0; i < used_bit_count; i += 1) {
+		const bool *element = jx_bit_ring_buffer_pop(buf);
+		XCTAssertTrue(element != NULL, "Missing bit %zu after resize.", i);
+		XCTAssertEqual(*element, expected_bit_for_growth_test(first_value + i),
+					   "Unexpected bit %zu after resize.", i);
+	}
+	
+	XCTAssertTrue(jx_bit_ring_buffer_is_empty(buf));
+}
+
+static void
+test_bit_ring_buffer_growth_with_bit_count(id self, size_t bit_count, size_t new_bit_count)
+{
+	jx_bit_ring_buffer buf;
+	jx_bit_ring_buffer_init(&buf, bit_count);
+	
+	// Move the window so that it wraps around the end of the storage.
+	const size_t offset = bit_count / 2 + 1;
+	for (size_t i = 0; i < offset; i += 1) {
+		jx_bit_ring_buffer_add(&buf, false);
+		jx_bit_ring_buffer_pop(&buf);
+	}
+	for (size_t i = 0; i < bit_count; i += 1) {
+		XCTAssertTrue(jx_bit_ring_buffer_add(&buf, expected_bit_for_growth_test(i)));
+	}
+	
+	XCTAssertTrue(jx_bit_ring_buffer_reserve(&buf, new_bit_count), "Cannot grow from %zu to %zu bits.", bit_count, new_bit_count);
+	XCTAssertEqual(jx_bit_ring_buffer_get_allocated_size(&buf), new_bit_count);
+	
+	// Keep adding past the old capacity.
+	for (size_t i = bit_count; i < new_bit_count; i += 1) {
+		XCTAssertTrue(jx_bit_ring_buffer_add(&buf, expected_bit_for_growth_test(i)));
+	}
+	XCTAssertTrue(jx_bit_ring_buffer_is_full(&buf));
+	
+	// Drop the oldest bits, then shrink back to the rest.
+	const size_t dropped_bit_count = new_bit_count - bit_count;
+	for (size_t i = 0; i < dropped_bit_count; i += 1) {
+		jx_bit_ring_buffer_pop(&buf);
+	}
+	XCTAssertTrue(jx_bit_ring_buffer_shrink_to_fit(&buf));
+	XCTAssertEqual(jx_bit_ring_buffer_get_allocated_size(&buf), bit_count);
+	
+	test_bit_ring_buffer_window(self, &buf, dropped_bit_count, bit_count);
+	
+	jx_bit_ring_buffer_done(&buf);
+}
+
+static void
+test_bit_ring_buffer_growth(id self)
+{
+	// Inline to inline, inline to heap, and heap to heap, at various alignments.
+	test_bit_ring_buffer_growth_with_bit_count(self, 4, 8);
+	test_bit_ring_buffer_growth_with_bit_count(self, 5, 64);
+	test_bit_ring_buffer_growth_with_bit_count(self, 60, 65);
+	test_bit_ring_buffer_growth_with_bit_count(self, 64, 200);
+	test_bit_ring_buffer_growth_with_bit_count(self, 65, 1000);
+	test_bit_ring_buffer_growth_with_bit_count(self, 333, 4097);
+	
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(1);
+	
+	for (size_t i = 0; i < 1000; i += 1) {
+		XCTAssertTrue(jx_bit_ring_buffer_add_with_growth(buf, expected_bit_for_growth_test(i)));
+	}
+	XCTAssertEqual(jx_bit_ring_buffer_get_allocated_size(buf), 1024,
+				   "Growth should be geometric.");
+	
+	test_bit_ring_buffer_window(self, buf, 0, 1000);
+	
+	XCTAssertTrue(jx_bit_ring_buffer_shrink_to_fit(buf));
+	XCTAssertEqual(jx_bit_ring_buffer_get_allocated_size(buf), 1);
+	
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	jx_bit_ring_buffer_snapshot *snapshot = jx_bit_ring_buffer_snapshot_new(buf);
+	XCTAssertFalse(jx_bit_ring_buffer_reserve(buf, 100),
+				   "Shouldn't move the storage while a snapshot reads it.");
+	jx_bit_ring_buffer_snapshot_free(snapshot);
+	XCTAssertTrue(jx_bit_ring_buffer_reserve(buf, 100));
+#endif
+	
+	jx_bit_ring_buffer_free(buf);
+}
+
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+static bool
+count_visited_bits(void *context, size_t index, bool element)
+{
+	(void)index;
+	
+	size_t *popcount = context;
+	*popcount += element;
+	
+	return true;
+}
+
+static void
+test_bit_ring_buffer_snapshot_with_bit_count(id self, size_t bit_count)
+{
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(bit_count);
+	
+	// Wrap around once, so that the window crosses the end of the storage.
+	for (size_t i = 0; i < bit_count + bit_count / 3; i += 1) {
+		jx_bit_ring_buffer_add_with_overwrite(buf, (i % 3) == 0);
+	}
+	for (size_t i = 0; i < bit_count / 5; i += 1) {
+		jx_bit_ring_buffer_pop(buf);
+	}
+	
+	const size_t used_bit_count = jx_bit_ring_buffer_get_used_bit_count(buf);
+	
+	bool *expected = calloc(used_bit_count, sizeof(bool));
+	size_t expected_popcount = 0;
+	for (size_t i = 0; i < used_bit_count; i += 1) {
+		expected[i] = jx_bitset_get(&buf->bitset, (buf->read_index + i) % bit_count);
+		expected_popcount += expected[i];
+	}
+	
+	jx_bit_ring_buffer_snapshot *snapshot = jx_bit_ring_buffer_snapshot_new(buf);
+	XCTAssertTrue(snapshot != NULL, "Cannot take snapshot.");
+	
+	// Overwrite everything with the inverse, then take a second snapshot.
+	for (size_t i = 0; i < bit_count; i += 1) {
+		jx_bit_ring_buffer_add_with_overwrite(buf, (i % 3) != 0);
+	}
+	jx_bit_ring_buffer_snapshot *later_snapshot = jx_bit_ring_buffer_snapshot_new(buf);
+	for (size_t i = 0; i < bit_count; i += 1) {
+		jx_bit_ring_buffer_add_with_overwrite(buf, true);
+	}
+	
+	XCTAssertEqual(jx_bit_ring_buffer_snapshot_get_used_bit_count(snapshot), used_bit_count);
+	
+	for (size_t i = 0; i < used_bit_count; i += 1) {
+		XCTAssertEqual(jx_bit_ring_buffer_snapshot_get(snapshot, i), expected[i],
+					   "Unexpected snapshot bit %zu for bit count %zu.", i, bit_count);
+	}
+	XCTAssertFalse(jx_bit_ring_buffer_snapshot_get(snapshot, used_bit_count),
+				   "Read past the snapshot for bit count %zu.", bit_count);
+	
+	XCTAssertEqual(jx_bit_ring_buffer_snapshot_population_count(snapshot), expected_popcount,
+				   "Unexpected snapshot popcount for bit count %zu.", bit_count);
+	
+	size_t visited_popcount = 0;
+	jx_bit_ring_buffer_snapshot_iterate(snapshot, count_visited_bits, &visited_popcount);
+	XCTAssertEqual(visited_popcount, expected_popcount,
+				   "Unexpected popcount while iterating snapshot for bit count %zu.", bit_count);
+	
+	size_t found_index = 0;
+	size_t start_index = 0;
+	while (jx_bit_ring_buffer_snapshot_find_next(snapshot, false, start_index, &found_index)) {
+		for (size_t i = start_index; i < found_index; i += 1) {
+			XCTAssertTrue(expected[i], "Skipped a 0-bit at %zu for bit count %zu.", i, bit_count);
+		}
+		XCTAssertFalse(expected[found_index], "Found a 1-bit at %zu for bit count %zu.", found_index, bit_count);
+		start_index = found_index + 1;
+	}
+	
+	XCTAssertEqual(jx_bit_ring_buffer_snapshot_population_count(later_snapshot), bit_count - (bit_count + 2) / 3,
+				   "Unexpected popcount of later snapshot for bit count %zu.", bit_count);
+	
+	jx_bit_ring_buffer_snapshot_free(snapshot);
+	jx_bit_ring_buffer_snapshot_free(later_snapshot);
+	
+	free(expected);
+	jx_bit_ring_buffer_free(buf);
+}
+
+/* The bit a concurrent writer adds as its `sequence_number`th bit. */
+static bool
+concurrent_snapshot_bit(size_t sequence_number)
+{
+	return ((sequence_number * 2654435761u) >> 7) & 0b1;
+}
+
+/* Snapshots handed from the writer to the reader thread, one at a time. */
+typedef struct concurrent_snapshot_handoff {
+	pthread_mutex_t lock;
+	pthread_cond_t  changed;
+	jx_bit_ring_buffer_snapshot *snapshot;
+	/* The number of bits added before `snapshot` was taken */
+	size_t  added_bit_count;
+	bool    is_done;
+	/* Results of the reader thread, read after joining it */
+	size_t  checked_count;
+	size_t  mismatch_count;
+} concurrent_snapshot_handoff;
+
+static void *
+read_concurrent_snapshots(void *context)
+{
+	concurrent_snapshot_handoff *handoff = context;
+	
+	pthread_mutex_lock(&handoff->lock);
+	
+	while (true) {
+		while ((handoff->snapshot == NULL) && !handoff->is_done) {
+			pthread_cond_wait(&handoff->changed, &handoff->lock);
+		}
+		
+		jx_bit_ring_buffer_snapshot *snapshot = handoff->snapshot;
+		if (snapshot == NULL) {
+			break;
+		}
+		
+		const size_t added_bit_count = handoff->added_bit_count;
+		handoff->snapshot = NULL;
+		pthread_cond_signal(&handoff->changed);
+		
+		// Read while the writer keeps going.
+		pthread_mutex_unlock(&handoff->lock);
+		
+		const size_t used_bit_count = jx_bit_ring_buffer_snapshot_get_used_bit_count(snapshot);
+		const size_t first_sequence_number = added_bit_count - used_bit_count;
+		size_t mismatch_count = 0;
+		size_t expected_popcount = 0;
+		
+		for (size_t i = 0; i < used_bit_count; i += 1) {
+			const bool expected = concurrent_snapshot_bit(first_sequence_number + i);
+			mismatch_count += (jx_bit_ring_buffer_snapshot_get(snapshot, i) != expected);
+			expected_popcount += expected;
+		}
+		
+		mismatch_count += (jx_bit_ring_buffer_snapshot_population_count(snapshot) != expected_popcount);
+		
+		jx_bit_ring_buffer_snapshot_free(snapshot);
+		
+		pthread_mutex_lock(&handoff->lock);
+		handoff->checked_count += 1;
+		handoff->mismatch_count += mismatch_count;
+	}
+	
+	pthread_mutex_unlock(&handoff->lock);
+	
+	return NULL;
+}
+
+static void
+test_bit_ring_buffer_snapshot_of_empty_storage(id self)
+{
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(0);
+	
+	jx_bit_ring_buffer_snapshot *snapshot = jx_bit_ring_buffer_snapshot_new(buf);
+	XCTAssertTrue(snapshot != NULL, "Cannot take snapshot of empty storage.");
+	
+	size_t found_index = 0;
+	XCTAssertEqual(jx_bit_ring_buffer_snapshot_get_used_bit_count(snapshot), 0);
+	XCTAssertFalse(jx_bit_ring_buffer_snapshot_get(snapshot, 0));
+	XCTAssertEqual(jx_bit_ring_buffer_snapshot_population_count(snapshot), 0);
+	XCTAssertFalse(jx_bit_ring_buffer_snapshot_find_next(snapshot, false, 0, &found_index));
+	
+	jx_bit_ring_buffer_snapshot_free(snapshot);
+	jx_bit_ring_buffer_free(buf);
+}
+
+static void
+test_bit_ring_buffer_snapshot_concurrent_reader(id self, size_t bit_count)
+{
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(bit_count);
+	
+	concurrent_snapshot_handoff handoff = {
+		.snapshot = NULL,
+		.added_bit_count = 0,
+		.is_done = false,
+		.checked_count = 0,
+		.mismatch_count = 0,
+	};
+	pthread_mutex_init(&handoff.lock, NULL);
+	pthread_cond_init(&handoff.changed, NULL);
+	
+	pthread_t reader;
+	XCTAssertEqual(pthread_create(&reader, NULL, read_concurrent_snapshots, &handoff), 0);
+	
+	const size_t total_bit_count = 64 * bit_count;
+	
+	for (size_t i = 0; i < total_bit_count; i += 1) {
+		// Hand over a new snapshot whenever the reader is done with the last one.
+		if ((i % 97) == 0) {
+			pthread_mutex_lock(&handoff.lock);
+			if (handoff.snapshot == NULL) {
+				handoff.snapshot = jx_bit_ring_buffer_snapshot_new(buf);
+				handoff.added_bit_count = i;
+				pthread_cond_signal(&handoff.changed);
+			}
+			pthread_mutex_unlock(&handoff.lock);
+		}
+		
+		jx_bit_ring_buffer_add_with_overwrite(buf, concurrent_snapshot_bit(i));
+
+	}
+	
+	pthread_mutex_lock(&handoff.lock);
+	handoff.is_done = true;
+	pthread_cond_signal(&handoff.changed);
+	pthread_mutex_unlock(&handoff.lock);
+	
+	pthread_join(reader, NULL);
+	
+	XCTAssertTrue(handoff.checked_count > 0, "The reader never got a snapshot for bit count %zu.", bit_count);
+	XCTAssertEqual(handoff.mismatch_count, 0,
+				   "Snapshots changed while being read for bit count %zu.", bit_count);
+	
+	pthread_cond_destroy(&handoff.changed);
+	pthread_mutex_destroy(&handoff.lock);
+	jx_bit_ring_buffer_free(buf);
+}
+
+/* A reader and a writer taking turns block by block. The turns are passed with
+ * relaxed atomics only, so that they don't add any synchronization that would
+ * hide a data race between the two from ThreadSanitizer. */
+typedef struct lockstep_snapshot_reader {
+	jx_bit_ring_buffer_snapshot *snapshot;
+	size_t  block_count;
+	/* Odd: the writer’s turn, even: the reader’s turn */
+	_Atomic size_t turn;
+	size_t  mismatch_count;
+} lockstep_snapshot_reader;
+
+static void
+wait_for_turn(lockstep_snapshot_reader *lockstep, size_t turn)
+{
+	while (atomic_load_explicit(&lockstep->turn, memory_order_relaxed) != turn) {
+		sched_yield();
+	}
+}
+
+static size_t
+count_concurrent_snapshot_mismatches(jx_bit_ring_buffer_snapshot *snapshot, size_t start_index, size_t end_index)
+{
+	size_t mismatch_count = 0;
+	
+	for (size_t i = start_index; i < end_index; i += 1) {
+		mismatch_count += (jx_bit_ring_buffer_snapshot_get(snapshot, i) != concurrent_snapshot_bit(i));
+	}
+	
+	return mismatch_count;
+}
+
+static void *
+read_snapshot_in_lockstep(void *context)
+{
+	lockstep_snapshot_reader *lockstep = context;
+	const size_t used_bit_count = jx_bit_ring_buffer_snapshot_get_used_bit_count(lockstep->snapshot);
+	
+	for (size_t block_index = 0; block_index < lockstep->block_count; block_index += 1) {
+		// Read the block while it is still live, then let the writer overwrite it.
+		const size_t start_index = block_index * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT;
+		size_t end_index = start_index + JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT;
+		if (end_index > used_bit_count) {
+			end_index = used_bit_count;
+		}
+		
+		lockstep->mismatch_count += count_concurrent_snapshot_mismatches(lockstep->snapshot, start_index, end_index);
+		
+		atomic_store_explicit(&lockstep->turn, 2 * block_index + 1, memory_order_relaxed);
+		wait_for_turn(lockstep, 2 * block_index + 2);
+	}
+	
+	// Every block has been overwritten by now, so this reads the copies.
+	lockstep->mismatch_count += count_concurrent_snapshot_mismatches(lockstep->snapshot, 0, used_bit_count);
+	
+	return NULL;
+}
+
+static void
+test_bit_ring_buffer_snapshot_lockstep_reader(id self, size_t bit_count)
+{
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(bit_count);
+	
+	for (size_t i = 0; i < bit_count; i += 1) {
+		jx_bit_ring_buffer_add(buf, concurrent_snapshot_bit(i));
+	}
+	
+	lockstep_snapshot_reader lockstep = {
+		.snapshot = jx_bit_ring_buffer_snapshot_new(buf),
+		.block_count = (bit_count + JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT - 1) / JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT,
+		.mismatch_count = 0,
+	};
+	atomic_init(&lockstep.turn, 0);
+	
+	pthread_t reader;
+	XCTAssertEqual(pthread_create(&reader, NULL, read_snapshot_in_lockstep, &lockstep), 0);
+	
+	// The window starts at index 0, so overwriting the oldest bits walks through the blocks in order.
+	for (size_t block_index = 0; block_index < lockstep.block_count; block_index += 1) {
+		wait_for_turn(&lockstep, 2 * block_index + 1);
+		
+		for (size_t i = 0; i < JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT; i += 1) {
+			jx_bit_ring_buffer_add_with_overwrite(buf, !concurrent_snapshot_bit(i));
+		}
+		
+		atomic_store_explicit(&lockstep.turn, 2 * block_index + 2, memory_order_relaxed);
+	}
+	
+	pthread_join(reader, NULL);
+	
+	XCTAssertEqual(lockstep.mismatch_count, 0,
+				   "Snapshot changed while being read in lockstep for bit count %zu.", bit_count);
+	
+	jx_bit_ring_buffer_snapshot_free(lockstep.snapshot);
+	jx_bit_ring_buffer_free(buf);
+}
+
+#ifdef JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC
+static bool snapshot_alloc_fails = false;
+static size_t snapshot_allocated_byte_count = 0;
+
+void *
+JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC(size_t size);
+
+void *
+JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC(size_t size)
+{
+	if (snapshot_alloc_fails) {
+		return NULL;
+	}
+	
+	snapshot_allocated_byte_count += size;
+	
+	return malloc(size);
+}
+
+static void
+test_bit_ring_buffer_snapshot_allocation_failure(id self)
+{
+	const size_t bit_count = 2 * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT;
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(bit_count);
+	
+	for (size_t i = 0; i < bit_count; i += 1) {
+		jx_bit_ring_buffer_add_with_overwrite(buf, true);
+	}
+	
+	jx_bit_ring_buffer_snapshot *snapshot = jx_bit_ring_buffer_snapshot_new(buf);
+	
+	// Without a copy of the block, the writes have to be refused.
+	snapshot_alloc_fails = true;
+	XCTAssertFalse(jx_bit_ring_buffer_add_with_overwrite(buf, false));
+	XCTAssertFalse(jx_bit_ring_buffer_pop(buf) == NULL);
+	XCTAssertFalse(jx_bit_ring_buffer_add(buf, false));
+	XCTAssertEqual(jx_bit_ring_buffer_get_used_bit_count(buf), bit_count - 1);
+	XCTAssertEqual(jx_bit_ring_buffer_snapshot_population_count(snapshot), bit_count);
+	
+	// Once memory is available again, the next write copies the block first.
+	snapshot_alloc_fails = false;
+	XCTAssertTrue(jx_bit_ring_buffer_add(buf, false));
+	XCTAssertTrue(jx_bit_ring_buffer_add_with_overwrite(buf, false));
+	XCTAssertEqual(jx_bit_ring_buffer_snapshot_population_count(snapshot), bit_count);
+	XCTAssertEqual(jx_bit_ring_buffer_population_count(buf), bit_count - 2);
+	
+	jx_bit_ring_buffer_snapshot_free(snapshot);
+	jx_bit_ring_buffer_free(buf);
+}
+
+/* Return the number of bytes a snapshot of a buffer with `bit_count` bits allocates
+ * for its bookkeeping, with 1000 bits written while it is alive. */
+static size_t
+snapshot_allocated_byte_count_for_bit_count(id self, size_t bit_count)
+{
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(bit_count);
+	
+	for (size_t i = 0; i < 1000; i += 1) {
+		jx_bit_ring_buffer_add(buf, (i % 3) == 0);
+	}
+	
+	snapshot_allocated_byte_count = 0;
+	
+	jx_bit_ring_buffer_snapshot *snapshot = jx_bit_ring_buffer_snapshot_new(buf);
+	for (size_t i = 0; i < 1000; i += 1) {
+		XCTAssertTrue(jx_bit_ring_buffer_add(buf, true));
+	}
+	XCTAssertEqual(jx_bit_ring_buffer_snapshot_population_count(snapshot), 334);
+	jx_bit_ring_buffer_snapshot_free(snapshot);
+	
+	const size_t allocated_byte_count = snapshot_allocated_byte_count;
+	
+	jx_bit_ring_buffer_free(buf);
+	
+	return allocated_byte_count;
+}
+
+static void
+test_bit_ring_buffer_snapshot_cost_is_independent_of_bit_count(id self)
+{
+	const size_t allocated_byte_count = snapshot_allocated_byte_count_for_bit_count(self, (size_t)1 << 12);
+	
+	// Bits 1000 to 1999 span three blocks, which get copied.
+	XCTAssertTrue(allocated_byte_count > 3 * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE);
+	XCTAssertTrue(allocated_byte_count < 4096);
+	
+	XCTAssertEqual(snapshot_allocated_byte_count_for_bit_count(self, (size_t)1 << 19), allocated_byte_count);
+	XCTAssertEqual(snapshot_allocated_byte_count_for_bit_count(self, (size_t)1 << 26), allocated_byte_count);
+}
+#endif
+
+static void
+test_bit_ring_buffer_snapshot(id self)
+{
+	test_bit_ring_buffer_snapshot_with_bit_count(self, 4);
+	test_bit_ring_buffer_snapshot_with_bit_count(self, 64);
+	test_bit_ring_buffer_snapshot_with_bit_count(self, 65);
+	test_bit_ring_buffer_snapshot_with_bit_count(self, JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT + 1);
+	test_bit_ring_buffer_snapshot_with_bit_count(self, 3 * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT + 17);
+	// Enough blocks for the table of block copies to grow a few times.
+	test_bit_ring_buffer_snapshot_with_bit_count(self, 40 * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT + 3);
+	test_bit_ring_buffer_snapshot_of_empty_storage(self);
+	
+	test_bit_ring_buffer_snapshot_concurrent_reader(self, 64);
+	test_bit_ring_buffer_snapshot_concurrent_reader(self, 4 * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT + 17);
+	// Enough blocks for the table of block copies to grow while the reader probes it.
+	test_bit_ring_buffer_snapshot_lockstep_reader(self, 40 * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT + 17);
+	
+#ifdef JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC
+	test_bit_ring_buffer_snapshot_allocation_failure(self);
+	test_bit_ring_buffer_snapshot_cost_is_independent_of_bit_count(self);
+#endif
+}
+#endif
+
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+static void
+expected_window_statistics(jx_bit_ring_buffer *buf, size_t bit_count,
+						   jx_bit_ring_buffer_window_statistics *statistics)
+{
+	memset(statistics, 0, sizeof(jx_bit_ring_buffer_window_statistics));
+	
+	const size_t used_bit_count = jx_bit_ring_buffer_get_used_bit_count(buf);
+	if (bit_count > used_bit_count) {
+		bit_count = used_bit_count;
+	}
+	
+	size_t run[2] = { 0, 0 };
+	bool previous = false;
+	
+	for (size_t i = used_bit_count - bit_count; i < used_bit_count; i += 1) {
+		const bool element = jx_bitset_get(&buf->bitset, (buf->read_index + i) % jx_bit_ring_buffer_get_allocated_size(buf));
+		
+		if (statistics->bit_count > 0) {
+			statistics->rising_edge_count += (!previous && element);
+			statistics->falling_edge_count += (previous && !element);
+		}
+		
+		statistics->bit_count += 1;
+		statistics->one_count += element;
+		
+		run[element] += 1;
+		run[!element] = 0;
+		
+		if (run[1] > statistics->longest_one_run) {
+			statistics->longest_one_run = run[1];
+		}
+		if (run[0] > statistics->longest_zero_run) {
+			statistics->longest_zero_run = run[0];
+		}
+		
+		previous = element;
+	}
+}
+
+static void
+test_window_statistics(id self, jx_bit_ring_buffer *buf, size_t bit_count)
+{
+	jx_bit_ring_buffer_window_statistics expected;
+	jx_bit_ring_buffer_window_statistics statistics;
+	
+	expected_window_statistics(buf, bit_count, &expected);
+	jx_bit_ring_buffer_get_window_statistics(buf, bit_count, &statistics);
+	
+	XCTAssertEqual(statistics.bit_count, expected.bit_count, "Window of %zu bits.", bit_count);
+	XCTAssertEqual(statistics.one_count, expected.one_count, "Window of %zu bits.", bit_count);
+	XCTAssertEqual(statistics.rising_edge_count, expected.rising_edge_count, "Window of %zu bits.", bit_count);
+	XCTAssertEqual(statistics.falling_edge_count, expected.falling_edge_count, "Window of %zu bits.", bit_count);
+	XCTAssertEqual(statistics.longest_one_run, expected.longest_one_run, "Window of %zu bits.", bit_count);
+	XCTAssertEqual(statistics.longest_zero_run, expected.longest_zero_run, "Window of %zu bits.", bit_count);
+	
+	XCTAssertEqual(jx_bit_ring_buffer_get_transition_count(buf, bit_count),
+				   expected.rising_edge_count + expected.falling_edge_count);
+	XCTAssertEqual(jx_bit_ring_buffer_get_longest_run(buf, bit_count, true), expected.longest_one_run);
+}
+
+static void
+test_tracked_edges(id self, jx_bit_ring_buffer *buf)
+{
+	jx_bit_ring_buffer_window_statistics expected;
+	expected_window_statistics(buf, jx_bit_ring_buffer_get_used_bit_count(buf), &expected);
+	
+	XCTAssertEqual(jx_bit_ring_buffer_get_rising_edge_count(buf), expected.rising_edge_count);
+	XCTAssertEqual(jx_bit_ring_buffer_get_falling_edge_count(buf), expected.falling_edge_count);
+}
+
+static void
+test_bit_ring_buffer_statistics_with_bit_count(id self, size_t bit_count)
+{
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(bit_count);
+	
+	test_window_statistics(self, buf, bit_count);
+	
+	// Long runs with a few flips, so that runs cross unit boundaries and the end of the storage.
+	uint32_t state = 12345;
+	for (size_t i = 0; i < bit_count + bit_count / 3; i += 1) {
+		state = state * 1103515245 + 12345;
+		jx_bit_ring_buffer_add_with_overwrite(buf, ((i / 70) % 2 == 0) != ((state >> 16) % 29 == 0));
+	}
+	for (size_t i = 0; i < bit_count / 7; i += 1) {
+		jx_bit_ring_buffer_pop(buf);
+	}
+	
+	const size_t window_bit_counts[] = { 0, 1, 2, 63, 64, 65, 130, bit_count / 2, bit_count - 1, bit_count, bit_count + 1 };
+	for (size_t i = 0; i < sizeof(window_bit_counts) / sizeof(window_bit_counts[0]); i += 1) {
+		test_window_statistics(self, buf, window_bit_counts[i]);
+	}
+	
+	// Track edges from here on, through adds, overwrites and pops.
+	jx_bit_ring_buffer_set_tracks_edges(buf, true);
+	test_tracked_edges(self, buf);
+	
+	for (size_t i = 0; i < 3 * bit_count; i += 1) {
+		state = state * 1103515245 + 12345;
+		const size_t action = (state >> 16) % 8;
+		const bool element = (state >> 20) & 0b1;
+		
+		if (action < 4) {
+			jx_bit_ring_buffer_add_with_overwrite(buf, element);
+		}
+		else if (action < 6) {
+			jx_bit_ring_buffer_add(buf, element);
+		}
+		else {
+			jx_bit_ring_buffer_pop(buf);
+		}
+		
+		test_tracked_edges(self, buf);
+	}
+	
+	jx_bit_ring_buffer_free(buf);
+}
+
+static void
+test_bit_ring_buffer_statistics(id self)
+{
+	test_bit_ring_buffer_statistics_with_bit_count(self, 1);
+	test_bit_ring_buffer_statistics_with_bit_count(self, 4);
+	test_bit_ring_buffer_statistics_with_bit_count(self, 64);
+	test_bit_ring_buffer_statistics_with_bit_count(self, 65);
+	test_bit_ring_buffer_statistics_with_bit_count(self, 333);
+	test_bit_ring_buffer_statistics_with_bit_count(self, 2000);
+	
+	// A single run across the end of the storage.
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(200);
+	for (size_t i = 0; i < 300; i += 1) {
+		jx_bit_ring_buffer_add_with_overwrite(buf, (i >= 50) && (i < 290));
+	}
+	XCTAssertEqual(jx_bit_ring_buffer_get_longest_run(buf, 200, true), 190);
+	XCTAssertEqual(jx_bit_ring_buffer_get_longest_run(buf, 200, false), 10);
+	XCTAssertEqual(jx_bit_ring_buffer_get_transition_count(buf, 200), 1);
+	XCTAssertEqual(jx_bit_ring_buffer_get_transition_count(buf, 10), 0);
+	jx_bit_ring_buffer_free(buf);
+}
+#endif
+
+#if JX_INSTRUMENTATION
+static void
+test_instrumentation_counters(id self)
+{
+	jx_instrumentation_reset();
+	
+	jx_bit_ring_buffer *buf = jx_bit_ring_buffer_new(4);
+	
+	XCTAssertEqual(jx_bit_ring_buffer_pop(buf), NULL);
+	
+	// Fill (4 adds), fail twice, then overwrite 3 times.
+	test_bit_ring_buffer_fill(self, buf);
+	XCTAssertFalse(jx_bit_ring_buffer_add(buf, true));
+	XCTAssertFalse(jx_bit_ring_buffer_add(buf, true));
+	jx_bit_ring_buffer_add_with_overwrite(buf, true);
+	jx_bit_ring_buffer_add_with_overwrite(buf, true);
+	jx_bit_ring_buffer_add_with_overwrite(buf, true);
+	
+	// Pop across the end of the storage.
+	for (size_t i = 0; i < 4; i += 1) {
+		XCTAssertTrue(jx_bit_ring_buffer_pop(buf) != NULL);
+	}
+	
+	jx_bit_ring_buffer_population_count(buf);
+	
+	jx_bitset *set = jx_bitset_new(1000);
+	jx_bitset_popcount(set);
+	jx_bitset_shift_all_bits_forward(set);
+	jx_bitset_shift_all_bits_forward(set);
+	jx_bitset_free(set);
+	
+	jx_instrumentation_counters counters;
+	jx_instrumentation_get_counters(&counters);
+	
+	XCTAssertEqual(counters.ring_adds, 7);
+	XCTAssertEqual(counters.ring_failed_adds, 2);
+	XCTAssertEqual(counters.ring_overwrites, 3);
+	XCTAssertEqual(counters.ring_pops, 4);
+	XCTAssertEqual(counters.ring_pops_on_empty, 1);
+	// Write index: after the 4th add. Read index: during the pops.
+	XCTAssertEqual(counters.ring_wraparounds, 2);
+	XCTAssertEqual(counters.bitset_popcount_calls, 2);
+	XCTAssertEqual(counters.bitset_popcount_bits_scanned, 4 + 1000);
+	XCTAssertEqual(counters.bitset_shift_calls, 2);
+	XCTAssertEqual(counters.bitset_shift_bits_scanned, 2 * 1000);
+	
+	jx_instrumentation_reset();
+	jx_instrumentation_get_counters(&counters);
+	XCTAssertEqual(counters.ring_adds, 0);
+	XCTAssertEqual(counters.bitset_popcount_bits_scanned, 0);
+	
+	// Shrinking a full buffer leaves the write index at 0 without wrapping around.
+	jx_bit_ring_buffer *full = jx_bit_ring_buffer_new(8);
+	for (size_t i = 0; i < 4; i += 1) {
+		XCTAssertTrue(jx_bit_ring_buffer_add(full, true));
+	}
+	jx_instrumentation_reset();
+	XCTAssertTrue(jx_bit_ring_buffer_shrink_to_fit(full));
+	XCTAssertTrue(jx_bit_ring_buffer_is_full(full));
+	jx_instrumentation_get_counters(&counters);
+	XCTAssertEqual(counters.ring_resizes, 1);
+	XCTAssertEqual(counters.ring_wraparounds, 0);
+	
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	// A live snapshot keeps the storage from growing.
+	jx_bit_ring_buffer_snapshot *snapshot = jx_bit_ring_buffer_snapshot_new(full);
+	XCTAssertFalse(jx_bit_ring_buffer_add_with_growth(full, true));
+	jx_instrumentation_get_counters(&counters);
+	XCTAssertEqual(counters.ring_failed_adds, 1);
+	jx_bit_ring_buffer_snapshot_free(snapshot);
+#endif
+	
+	jx_bit_ring_buffer_free(full);
+	
+	jx_bit_ring_buffer_free(buf);
+}
+#endif
+
+#endif /* BIT_RING_BUFFER_TEST_CASES_H */
@@ -0,0 +1,73 @@
+//
+//  bit_ring_buffer_tests.c
+//  bit-ring-buffer-Tests
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  Runs the test cases of bit_ring_buffer_Tests.m without XCTest.
+//  Optionally takes the name of a single test to run.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "xctest-compat.h"
+#include "bit_ring_buffer_test_cases.h"
+
+
+size_t xctest_compat_failure_count = 0;
+
+typedef struct test_case {
+	const char *name;
+	void (*run)(id self);
+} test_case;
+
+static const test_case test_cases[] = {
+	{ "testBitset", test_bitset },
+	{ "testBitsetKernels", test_bitset_kernels },
+#if JX_BITSET_USE_THREAD_POOL
+	{ "testBitsetParallel", test_bitset_parallel },
+#endif
+	{ "testBitRingBuffer", test_bit_ring_buffer },
+	{ "testBitRingBufferGrowth", test_bit_ring_buffer_growth },
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	{ "testBitRingBufferSnapshot", test_bit_ring_buffer_snapshot },
+#endif
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+	{ "testBitRingBufferStatistics", test_bit_ring_buffer_statistics },
+#endif
+#if JX_INSTRUMENTATION
+	{ "testInstrumentationCounters", test_instrumentation_counters },
+#endif
+};
+
+int
+main(int argc, const char *argv[])
+{
+	const char *selected_name = (argc > 1) ? argv[1] : NULL;
+	size_t run_count = 0;
+	
+	printf("Bitset kernels: %s\n", jx_bitset_get_kernels()->name);
+	
+	for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i += 1) {
+		if ((selected_name != NULL) && (strcmp(selected_name, test_cases[i].name) != 0)) {
+			continue;
+		}
+		
+		const size_t previous_failure_count = xctest_compat_failure_count;
+		
+		test_cases[i].run(NULL);
+		run_count += 1;
+		
+		printf("%s %s\n", test_cases[i].name,
+			   (xctest_compat_failure_count == previous_failure_count) ? "passed" : "failed");
+	}
+	
+	if (run_count == 0) {
+		fprintf(stderr, "No test named %s.\n", selected_name);
+		return EXIT_FAILURE;
+	}
+	
+	return (xctest_compat_failure_count == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,45 @@
+//
+//  xctest-compat.h
+//  bit-ring-buffer-Tests
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  Just enough of the XCTest assertions to run the shared test cases
+//  on platforms without XCTest.
+//
+
+#ifndef XCTEST_COMPAT_H
+#define XCTEST_COMPAT_H
+
+#include <stdio.h>
+
+
+/* The test cases pass their test case object around as `self`.
+ * Like the XCTest assertions, the ones below refer to it. */
+typedef void *id;
+
+extern size_t xctest_compat_failure_count;
+
+#define xctest_compat_fail(description, ...) \
+	((void)self, \
+	 xctest_compat_failure_count += 1, \
+	 fprintf(stderr, "%s:%d: error: %s.", __FILE__, __LINE__, (description)), \
+	 fprintf(stderr, " " __VA_ARGS__), \
+	 fprintf(stderr, "\n"))
+
+#define XCTAssertTrue(expression, ...) \
+	((expression) ? (void)0 : (void)xctest_compat_fail("(" #expression ") is not true", ##__VA_ARGS__))
+
+#define XCTAssertFalse(expression, ...) \
+	(!(expression) ? (void)0 : (void)xctest_compat_fail("(" #expression ") is not false", ##__VA_ARGS__))
+
+#define XCTAssertEqual(expression1, expression2, ...) \
+	(((expression1) == (expression2)) ? (void)0 : \
+	 (void)xctest_compat_fail("(" #expression1 ") is not equal to (" #expression2 ")", ##__VA_ARGS__))
+
+#define XCTAssertNotEqual(expression1, expression2, ...) \
+	(((expression1) != (expression2)) ? (void)0 : \
+	 (void)xctest_compat_fail("(" #expression1 ") is equal to (" #expression2 ")", ##__VA_ARGS__))
+
+#endif /* XCTEST_COMPAT_H */
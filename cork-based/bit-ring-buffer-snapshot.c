@@ -0,0 +1,695 @@
+//
+//  bit-ring-buffer-snapshot.c
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#include "bit-ring-buffer-snapshot.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+
+/* Tests define this to an allocator of their own, to count the memory of the
+ * generations and block copies, and to make the block copies of the writer fail. */
+#ifdef JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC
+void *
+JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC(size_t size);
+#else
+#define JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC malloc
+#endif
+
+/* The number of slots in the first copy table of a generation. Must be a power of 2. */
+#define JX_BIT_RING_BUFFER_SNAPSHOT_MIN_SLOT_COUNT	8
+
+typedef struct jx_bit_ring_buffer_block_copy {
+	size_t  block_index;
+	uint8_t bytes[JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE];
+} jx_bit_ring_buffer_block_copy;
+
+/* An open-addressed hash table of the block copies of a generation, with linear probing.
+ * The writer only ever fills empty slots, so readers can probe it without the lock.
+ * When it gets too full, the writer replaces it with a larger one; the smaller one
+ * stays around for readers still probing it until the generation is freed. */
+typedef struct jx_bit_ring_buffer_block_table jx_bit_ring_buffer_block_table;
+
+struct jx_bit_ring_buffer_block_table {
+	/* A power of 2 */
+	size_t  slot_count;
+	/* The table this one replaced */
+	jx_bit_ring_buffer_block_table *retired;
+	_Atomic(jx_bit_ring_buffer_block_copy *) slots[];
+};
+
+struct jx_bit_ring_buffer_generation {
+	/* The epoch in which the writer copied the blocks of this generation */
+	size_t  epoch;
+	/* The number of snapshots that start reading in this generation. Guarded by the lock. */
+	size_t  snapshot_count;
+	/* The number of block copies in `table`. Guarded by the lock. */
+	size_t  copy_count;
+	/* The contents of the blocks copied so far, as of the start of this generation.
+	 * NULL until the first copy, so that taking a snapshot doesn’t depend on the size of the buffer. */
+	_Atomic(jx_bit_ring_buffer_block_table *) table;
+	/* The next newer generation */
+	_Atomic(jx_bit_ring_buffer_generation *) newer;
+};
+
+/* The generations form a list from oldest to newest. A generation is only freed
+ * once it and all generations before it have no snapshots left, so a reader can
+ * always walk forward from its own generation. */
+struct jx_bit_ring_buffer_snapshot_state {
+	pthread_mutex_t lock;
+	
+	/* The epoch of the newest generation. Only used by the writer. */
+	size_t  epoch;
+	/* The last block the writer preserved, and the epoch it did so in.
+	 * Writes are mostly sequential, so this saves the lookup for all but
+	 * the first write to each block. Only used by the writer. */
+	size_t  cached_block_index;
+	size_t  cached_epoch;
+	/* Whether the buffer changed since the newest generation started. Only used by the writer. */
+	bool    is_modified;
+	
+	/* Guarded by the lock */
+	jx_bit_ring_buffer_generation *oldest;
+	jx_bit_ring_buffer_generation *newest;
+};
+
+/* Visit the bits [first_bit, end_bit) of a copy of a single block.
+ * `index` is the snapshot index of `first_bit`. Return `false` to stop. */
+typedef bool
+(*jx_bit_ring_buffer_block_visitor)(void *context, jx_bitset *block,
+									size_t first_bit, size_t end_bit, size_t index);
+
+
+static size_t
+block_byte_count(jx_bit_ring_buffer *buf, size_t block_index)
+{
+	const size_t byte_offset = block_index * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE;
+	const size_t remaining = buf->bitset.byte_count - byte_offset;
+	
+	return (remaining < JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE) ? remaining : JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE;
+}
+
+static size_t
+block_table_first_slot(jx_bit_ring_buffer_block_table *table, size_t block_index)
+{
+	// Fibonacci hashing, folded so that the low bits depend on all of the index.
+	uint64_t hash = (uint64_t)block_index * 0x9E3779B97F4A7C15u;
+	hash ^= hash >> 32;
+	
+	return (size_t)hash & (table->slot_count - 1);
+}
+
+static jx_bit_ring_buffer_block_table *
+jx_bit_ring_buffer_block_table_new(size_t slot_count)
+{
+	jx_bit_ring_buffer_block_table *table =
+		JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC(sizeof(jx_bit_ring_buffer_block_table) +
+										  slot_count * sizeof(_Atomic(jx_bit_ring_buffer_block_copy *)));
+	if (table == NULL) {
+		return NULL;
+	}
+	
+	table->slot_count = slot_count;
+	table->retired = NULL;
+	
+	for (size_t i = 0; i < slot_count; i += 1) {
+		atomic_init(&table->slots[i], NULL);
+	}
+	
+	return table;
+}
+
+/* Put `copy` into the first empty slot for its block. Only the writer calls this. */
+static void
+jx_bit_ring_buffer_block_table_insert(jx_bit_ring_buffer_block_table *table, jx_bit_ring_buffer_block_copy *copy)
+{
+	size_t slot = block_table_first_slot(table, copy->block_index);
+	
+	while (atomic_load_explicit(&table->slots[slot], memory_order_relaxed) != NULL) {
+		slot = (slot + 1) & (table->slot_count - 1);
+	}
+	
+	atomic_store_explicit(&table->slots[slot], copy, memory_order_release);
+}
+
+static jx_bit_ring_buffer_block_copy *
+jx_bit_ring_buffer_block_table_find(jx_bit_ring_buffer_block_table *table, size_t block_index)
+{
+	size_t slot = block_table_first_slot(table, block_index);
+	
+	// The table always has empty slots, so this terminates.
+	while (true) {
+		jx_bit_ring_buffer_block_copy *copy = atomic_load_explicit(&table->slots[slot], memory_order_acquire);
+		
+		if ((copy == NULL) || (copy->block_index == block_index)) {
+			return copy;
+		}
+		
+		slot = (slot + 1) & (table->slot_count - 1);
+	}
+}
+
+static jx_bit_ring_buffer_snapshot_state *
+jx_bit_ring_buffer_snapshot_state_new(void)
+{
+	jx_bit_ring_buffer_snapshot_state *state = calloc(1, sizeof(jx_bit_ring_buffer_snapshot_state));
+	if (state == NULL) {
+		return NULL;
+	}
+	
+	pthread_mutex_init(&state->lock, NULL);
+	// The cached epoch starts out as 0, which is older than any generation.
+	state->is_modified = true;
+	
+	return state;
+}
+
+void
+jx_bit_ring_buffer_snapshot_state_free(jx_bit_ring_buffer *buf)
+{
+	jx_bit_ring_buffer_snapshot_state *state = buf->snapshot_state;
+	if (state == NULL) {
+		return;
+	}
+	
+	pthread_mutex_destroy(&state->lock);
+	free(state);
+	
+	buf->snapshot_state = NULL;
+}
+
+bool
+jx_bit_ring_buffer_snapshot_state_is_in_use(jx_bit_ring_buffer *buf)
+{
+	jx_bit_ring_buffer_snapshot_state *state = buf->snapshot_state;
+	if (state == NULL) {
+		return false;
+	}
+	
+	pthread_mutex_lock(&state->lock);
+	const bool is_in_use = (state->oldest != NULL);
+	pthread_mutex_unlock(&state->lock);
+	
+	return is_in_use;
+}
+
+static jx_bit_ring_buffer_generation *
+jx_bit_ring_buffer_generation_new(size_t epoch)
+{
+	jx_bit_ring_buffer_generation *generation = JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC(sizeof(jx_bit_ring_buffer_generation));
+	if (generation == NULL) {
+		return NULL;
+	}
+	
+	generation->epoch = epoch;
+	generation->snapshot_count = 0;
+	generation->copy_count = 0;
+	atomic_init(&generation->table, NULL);
+	atomic_init(&generation->newer, NULL);
+	
+	return generation;
+}
+
+static void
+jx_bit_ring_buffer_generation_free(jx_bit_ring_buffer_generation *generation)
+{
+	jx_bit_ring_buffer_block_table *table = atomic_load_explicit(&generation->table, memory_order_relaxed);
+	
+	// The current table has all of the copies, the retired ones only some of the same.
+	if (table != NULL) {
+		for (size_t i = 0; i < table->slot_count; i += 1) {
+			free(atomic_load_explicit(&table->slots[i], memory_order_relaxed));
+		}
+	}
+	
+	while (table != NULL) {
+		jx_bit_ring_buffer_block_table *retired = table->retired;
+		free(table);
+		table = retired;
+	}
+	
+	free(generation);
+}
+
+/* Add a copy of a block to the newest generation, growing its table if needed.
+ * Return false if out of memory. Only the writer calls this, with the lock held. */
+static bool
+jx_bit_ring_buffer_generation_add_copy(jx_bit_ring_buffer_generation *generation, jx_bit_ring_buffer *buf,
+									   size_t block_index)
+{
+	jx_bit_ring_buffer_block_table *table = atomic_load_explicit(&generation->table, memory_order_relaxed);
+	
+	// Keep the load factor at or below 3/4.
+	if ((table == NULL) || (4 * (generation->copy_count + 1) > 3 * table->slot_count)) {
+		const size_t slot_count = (table != NULL) ? (2 * table->slot_count) : JX_BIT_RING_BUFFER_SNAPSHOT_MIN_SLOT_COUNT;
+		
+		jx_bit_ring_buffer_block_table *larger_table = jx_bit_ring_buffer_block_table_new(slot_count);
+		if (larger_table == NULL) {
+			return false;
+		}
+		
+		if (table != NULL) {
+			for (size_t i = 0; i < table->slot_count; i += 1) {
+				jx_bit_ring_buffer_block_copy *copy = atomic_load_explicit(&table->slots[i], memory_order_relaxed);
+				if (copy != NULL) {
+					jx_bit_ring_buffer_block_table_insert(larger_table, copy);
+				}
+			}
+		}
+		
+		larger_table->retired = table;
+		atomic_store_explicit(&generation->table, larger_table, memory_order_release);
+		table = larger_table;
+	}
+	
+	jx_bit_ring_buffer_block_copy *copy = JX_BIT_RING_BUFFER_SNAPSHOT_ALLOC(sizeof(jx_bit_ring_buffer_block_copy));
+	if (copy == NULL) {
+		return false;
+	}
+	
+	copy->block_index = block_index;
+	const size_t byte_offset = block_index * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE;
+	memcpy(copy->bytes, &(buf->bitset.bits[byte_offset]), block_byte_count(buf, block_index));
+	
+	jx_bit_ring_buffer_block_table_insert(table, copy);
+	generation->copy_count += 1;
+	
+	return true;
+}
+
+/* Return the copy of a block made in `generation`, or NULL if there is none (yet). */
+static jx_bit_ring_buffer_block_copy *
+jx_bit_ring_buffer_generation_find_copy(jx_bit_ring_buffer_generation *generation, size_t block_index)
+{
+	jx_bit_ring_buffer_block_table *table = atomic_load_explicit(&generation->table, memory_order_acquire);
+	if (table == NULL) {
+		return NULL;
+	}
+	
+	return jx_bit_ring_buffer_block_table_find(table, block_index);
+}
+
+jx_bit_ring_buffer_snapshot *
+jx_bit_ring_buffer_snapshot_new(jx_bit_ring_buffer *buf)
+{
+	if (buf->snapshot_state == NULL) {
+		buf->snapshot_state = jx_bit_ring_buffer_snapshot_state_new();
+		if (buf->snapshot_state == NULL) {
+			return NULL;
+		}
+	}
+	
+	jx_bit_ring_buffer_snapshot_state *state = buf->snapshot_state;
+	
+	jx_bit_ring_buffer_snapshot *snapshot = malloc(sizeof(jx_bit_ring_buffer_snapshot));
+	if (snapshot == NULL) {
+		return NULL;
+	}
+	
+	pthread_mutex_lock(&state->lock);
+	
+	jx_bit_ring_buffer_generation *generation = state->newest;
+	
+	if ((generation == NULL) || state->is_modified) {
+		generation = jx_bit_ring_buffer_generation_new(state->epoch + 1);
+		if (generation == NULL) {
+			pthread_mutex_unlock(&state->lock);
+			free(snapshot);
+			return NULL;
+		}
+		
+		if (state->newest != NULL) {
+			atomic_store_explicit(&state->newest->newer, generation, memory_order_release);
+		}
+		else {
+			state->oldest = generation;
+		}
+		
+		state->newest = generation;
+		state->epoch = generation->epoch;
+		state->is_modified = false;
+	}
+	
+	generation->snapshot_count += 1;
+	
+	pthread_mutex_unlock(&state->lock);
+	
+	snapshot->buf = buf;
+	snapshot->generation = generation;
+	snapshot->used_bit_count = buf->used_bit_count;
+	snapshot->read_index = buf->read_index;
+	
+	return snapshot;
+}
+
+void
+jx_bit_ring_buffer_snapshot_free(jx_bit_ring_buffer_snapshot *snapshot)
+{
+	jx_bit_ring_buffer_snapshot_state *state = snapshot->buf->snapshot_state;
+	
+	pthread_mutex_lock(&state->lock);
+	
+	snapshot->generation->snapshot_count -= 1;
+	
+	while ((state->oldest != NULL) && (state->oldest->snapshot_count == 0)) {
+		jx_bit_ring_buffer_generation *oldest = state->oldest;
+		state->oldest = atomic_load_explicit(&oldest->newer, memory_order_relaxed);
+		jx_bit_ring_buffer_generation_free(oldest);
+	}
+	
+	if (state->oldest == NULL) {
+		state->newest = NULL;
+	}
+	
+	pthread_mutex_unlock(&state->lock);
+	
+	free(snapshot);
+}
+
+bool
+jx_bit_ring_buffer_snapshot_will_write(jx_bit_ring_buffer *buf, size_t bit_index)
+{
+	jx_bit_ring_buffer_snapshot_state *state = buf->snapshot_state;
+	
+	state->is_modified = true;
+	
+	const size_t block_index = bit_index / JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT;
+	
+	// Each block is copied at most once per generation.
+	if ((state->cached_epoch == state->epoch) && (state->cached_block_index == block_index)) {
+		return true;
+	}
+	
+	bool is_preserved = true;
+	
+	pthread_mutex_lock(&state->lock);
+	
+	// Without a newest generation, there are no snapshots to preserve the block for.
+	jx_bit_ring_buffer_generation *newest = state->newest;
+	
+	if ((newest != NULL) && (jx_bit_ring_buffer_generation_find_copy(newest, block_index) == NULL)) {
+		// If this fails, the caller must not modify the block. The next write to it tries again.
+		is_preserved = jx_bit_ring_buffer_generation_add_copy(newest, buf, block_index);
+	}
+	
+	pthread_mutex_unlock(&state->lock);
+	
+	if (!is_preserved) {
+		return false;
+	}
+	
+	state->cached_block_index = block_index;
+	state->cached_epoch = state->epoch;
+	
+	// Publish the copy before the caller modifies the block.
+	atomic_thread_fence(memory_order_release);
+	
+	return true;
+}
+
+/* The first copy made in or after the snapshot’s generation holds the block as it was
+ * when the snapshot was taken. If there is none, the block has not changed since. */
+static uint8_t *
+find_block_copy(jx_bit_ring_buffer_snapshot *snapshot, size_t block_index)
+{
+	jx_bit_ring_buffer_generation *generation = snapshot->generation;
+	
+	while (generation != NULL) {
+		jx_bit_ring_buffer_block_copy *copy = jx_bit_ring_buffer_generation_find_copy(generation, block_index);
+		if (copy != NULL) {
+			return copy->bytes;
+		}
+		
+		generation = atomic_load_explicit(&generation->newer, memory_order_acquire);
+	}
+	
+	return NULL;
+}
+
+/* Load the live bytes of a block while the writer may be modifying them.
+ *
+ * The writer stores to the block with relaxed atomic byte stores once the buffer
+ * has a snapshot state (jx_bit_ring_buffer_set_bit()), and publishes its copy of
+ * the block, followed by a release fence, before the first of them. The reader
+ * loads the bytes with relaxed atomic loads, issues an acquire fence and looks
+ * for a copy again. If any byte it loaded was already modified, the fences
+ * guarantee that it finds the copy, and the bytes it loaded are discarded.
+ * Every access to shared bytes is atomic, so there is no data race. */
+static void
+load_live_block(jx_bit_ring_buffer_snapshot *snapshot, size_t block_index, uint8_t *bytes, size_t byte_count)
+{
+	const uint8_t *live_bytes = &(snapshot->buf->bitset.bits[block_index * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE]);
+	
+	for (size_t i = 0; i < byte_count; i += 1) {
+		bytes[i] = __atomic_load_n(&live_bytes[i], __ATOMIC_RELAXED);
+	}
+}
+
+static void
+read_block(jx_bit_ring_buffer_snapshot *snapshot, size_t block_index, uint8_t *bytes)
+{
+	const size_t byte_count = block_byte_count(snapshot->buf, block_index);
+	
+	uint8_t *copy = find_block_copy(snapshot, block_index);
+	
+	if (copy == NULL) {
+		load_live_block(snapshot, block_index, bytes, byte_count);
+		
+		// If the writer got to the block while we were reading it,
+		// it has published a copy first. Use that instead.
+		atomic_thread_fence(memory_order_acquire);
+		copy = find_block_copy(snapshot, block_index);
+	}
+	
+	if (copy != NULL) {
+		memcpy(bytes, copy, byte_count);
+	}
+}
+
+static void
+visit_blocks(jx_bit_ring_buffer_snapshot *snapshot, size_t start_index,
+			 jx_bit_ring_buffer_block_visitor visitor, void *context)
+{
+	const size_t bit_count = jx_bit_ring_buffer_get_allocated_size(snapshot->buf);
+	
+	uint8_t bytes[JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE] = {0};
+	
+	jx_bitset block;
+	block.bits = bytes;
+	block.bit_count = JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT;
+	block.byte_count = JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE;
+	
+	size_t index = start_index;
+	
+	while (index < snapshot->used_bit_count) {
+		size_t physical_index = snapshot->read_index + index;
+		if (physical_index >= bit_count) {
+			physical_index -= bit_count;
+		}
+		
+		const size_t block_index = physical_index / JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT;
+		const size_t block_start = block_index * JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT;
+		
+		const size_t first_bit = physical_index - block_start;
+		
+		// Stop at the end of the block, the end of the storage (wraparound) or the end of the window.
+		size_t end_bit = JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT;
+		if (bit_count - block_start < end_bit) {
+			end_bit = bit_count - block_start;
+		}
+		if (first_bit + (snapshot->used_bit_count - index) < end_bit) {
+			end_bit = first_bit + (snapshot->used_bit_count - index);
+		}
+		
+		read_block(snapshot, block_index, bytes);
+		
+		if (!visitor(context, &block, first_bit, end_bit, index)) {
+			return;
+		}
+		
+		index += end_bit - first_bit;
+	}
+}
+
+bool
+jx_bit_ring_buffer_snapshot_get(jx_bit_ring_buffer_snapshot *snapshot, size_t index)
+{
+	// Like find_next and iteration, stay inside the window. This also covers empty storage.
+	if (index >= snapshot->used_bit_count) {
+		return false;
+	}
+	
+	const size_t bit_count = jx_bit_ring_buffer_get_allocated_size(snapshot->buf);
+	
+	const size_t physical_index = (snapshot->read_index + index) % bit_count;
+	const size_t block_index = physical_index / JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT;
+	
+	uint8_t bytes[JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE];
+	read_block(snapshot, block_index, bytes);
+	
+	jx_bitset block;
+	block.bits = bytes;
+	
+	return jx_bitset_get(&block, physical_index % JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT);
+}
+
+static bool
+count_bits_in_block(void *context, jx_bitset *block, size_t first_bit, size_t end_bit, size_t index)
+{
+	(void)index;
+	
+	size_t *popcount = context;
+	size_t i = first_bit;
+	
+	for (; (i < end_bit) && (jx_bitset_bit_offset_in_byte(i) != 0); i += 1) {
+		*popcount += jx_bitset_get(block, i);
+	}
+	
+	// Whole bytes don’t depend on the bit order.
+	for (; i + JX_BITSET_BITS_PER_BYTE <= end_bit; i += JX_BITSET_BITS_PER_BYTE) {
+		*popcount += __builtin_popcount(jx_bitset_byte_for_bit(block, i));
+	}
+	
+	for (; i < end_bit; i += 1) {
+		*popcount += jx_bitset_get(block, i);
+	}
+	
+	return true;
+}
+
+size_t
+jx_bit_ring_buffer_snapshot_population_count(jx_bit_ring_buffer_snapshot *snapshot)
+{
+	size_t popcount = 0;
+	
+	visit_blocks(snapshot, 0, count_bits_in_block, &popcount);
+	
+	return popcount;
+}
+
+typedef struct jx_bit_ring_buffer_search {
+	bool    element;
+	bool    found;
+	size_t  found_index;
+} jx_bit_ring_buffer_search;
+
+static bool
+search_block(void *context, jx_bitset *block, size_t first_bit, size_t end_bit, size_t index)
+{
+	jx_bit_ring_buffer_search *search = context;
+	
+	// Bytes made up entirely of the other value can be skipped as a whole.
+	const uint8_t other_byte = search->element ? 0x00 : 0xFF;
+	
+	for (size_t i = first_bit; i < end_bit; i += 1) {
+		if ((jx_bitset_bit_offset_in_byte(i) == 0) &&
+			(i + JX_BITSET_BITS_PER_BYTE <= end_bit) &&
+			(jx_bitset_byte_for_bit(block, i) == other_byte)) {
+			i += JX_BITSET_BITS_PER_BYTE - 1;
+			continue;
+		}
+		
+		if (jx_bitset_get(block, i) == search->element) {
+			search->found = true;
+			search->found_index = index + (i - first_bit);
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+bool
+jx_bit_ring_buffer_snapshot_find_next(jx_bit_ring_buffer_snapshot *snapshot, bool element,
+									  size_t start_index, size_t *found_index)
+{
+	jx_bit_ring_buffer_search search = {
+		.element = element,
+		.found = false,
+		.found_index = 0,
+	};
+	
+	visit_blocks(snapshot, start_index, search_block, &search);
+	
+	if (search.found) {
+		*found_index = search.found_index;
+	}
+	
+	return search.found;
+}
+
+typedef struct jx_bit_ring_buffer_iteration {
+	jx_bit_ring_buffer_snapshot_visitor visitor;
+	void   *context;
+} jx_bit_ring_buffer_iteration;
+
+static bool
+iterate_block(void *context, jx_bitset *block, size_t first_bit, size_t end_bit, size_t index)
+{
+	jx_bit_ring_buffer_iteration *iteration = context;
+	
+	for (size_t i = first_bit; i < end_bit; i += 1) {
+		if (!iteration->visitor(iteration->context, index + (i - first_bit), jx_bitset_get(block, i))) {
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+void
+jx_bit_ring_buffer_snapshot_iterate(jx_bit_ring_buffer_snapshot *snapshot,
+									jx_bit_ring_buffer_snapshot_visitor visitor, void *context)
+{
+	jx_bit_ring_buffer_iteration iteration = {
+		.visitor = visitor,
+		.context = context,
+	};
+	
+	visit_blocks(snapshot, 0, iterate_block, &iteration);
+}
+
+#endif
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
@@ -0,0 +1,145 @@
+//
+//  bit-ring-buffer-snapshot.h
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#ifndef LIBJX_DS_BIT_RING_BUFFER_SNAPSHOT_H
+#define LIBJX_DS_BIT_RING_BUFFER_SNAPSHOT_H
+
+#include "bit-ring-buffer.h"
+
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+
+/*-----------------------------------------------------------------------
+ * Read snapshots of a bit ring buffer
+ *
+ * A snapshot is a frozen view of the window of a live ring buffer.
+ * It shares its storage with the buffer: taking one only records the
+ * window, and the writer copies a block the first time it modifies it
+ * after a snapshot was taken. Snapshots taken without any write in between
+ * share the same generation of block copies.
+ *
+ * Snapshots have to be taken on the thread that writes to the buffer
+ * (or under the same lock). Once taken, they can be read and freed from
+ * any thread while the writer keeps adding. The buffer must outlive all
+ * of its snapshots.
+ *
+ * Copying a block needs memory. While snapshots exist, an add that would
+ * modify a block that cannot be copied is refused instead:
+ * jx_bit_ring_buffer_add() and jx_bit_ring_buffer_add_with_overwrite()
+ * return false and leave the buffer unchanged, so snapshots never see
+ * a partial write.
+ */
+
+/* The number of bytes the writer copies at a time. */
+#define JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE	64
+#define JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_BIT_COUNT \
+	(JX_BIT_RING_BUFFER_SNAPSHOT_BLOCK_SIZE * JX_BITSET_BITS_PER_BYTE)
+
+typedef struct jx_bit_ring_buffer_generation jx_bit_ring_buffer_generation;
+
+typedef struct jx_bit_ring_buffer_snapshot {
+	/* The buffer this is a snapshot of */
+	jx_bit_ring_buffer *buf;
+	/* The block copies made since the snapshot was taken start in this generation. */
+	jx_bit_ring_buffer_generation *generation;
+	/* The window of the buffer at the time the snapshot was taken */
+	size_t  used_bit_count;
+	size_t  read_index;
+} jx_bit_ring_buffer_snapshot;
+
+/* Called with the index of each bit the visitor should look at, starting with
+ * the oldest bit in the snapshot. Return `false` to stop the iteration. */
+typedef bool
+(*jx_bit_ring_buffer_snapshot_visitor)(void *context, size_t index, bool element);
+
+
+/* Take a snapshot of the current window of `buf`, or return NULL if out of memory.
+ * This takes constant time, whatever the size of the buffer: the writer only
+ * keeps track of the blocks it actually copies. */
+jx_bit_ring_buffer_snapshot *
+jx_bit_ring_buffer_snapshot_new(jx_bit_ring_buffer *buf);
+
+void
+jx_bit_ring_buffer_snapshot_free(jx_bit_ring_buffer_snapshot *snapshot);
+
+/* Return the number of bits in the snapshot. */
+#define jx_bit_ring_buffer_snapshot_get_used_bit_count(snapshot) \
+	((snapshot)->used_bit_count)
+
+/* Return the bit at `index`, counted from the oldest bit in the snapshot.
+ * Return false if `index` is not less than the number of bits in the snapshot. */
+bool
+jx_bit_ring_buffer_snapshot_get(jx_bit_ring_buffer_snapshot *snapshot, size_t index);
+
+/* Return the number of 1-bits in the snapshot. */
+size_t
+jx_bit_ring_buffer_snapshot_population_count(jx_bit_ring_buffer_snapshot *snapshot);
+
+/* Find the first bit at or after `start_index` that equals `element`.
+ * Return whether there is one and store its index in `found_index`. */
+bool
+jx_bit_ring_buffer_snapshot_find_next(jx_bit_ring_buffer_snapshot *snapshot, bool element,
+									  size_t start_index, size_t *found_index);
+
+/* Call `visitor` for every bit in the snapshot, oldest first. */
+void
+jx_bit_ring_buffer_snapshot_iterate(jx_bit_ring_buffer_snapshot *snapshot,
+									jx_bit_ring_buffer_snapshot_visitor visitor, void *context);
+
+
+/* For the writer: preserve the block containing `bit_index` for the snapshots
+ * that still need it. Only call this if `buf` has a snapshot state.
+ * Return false if the block could not be copied (out of memory):
+ * the caller must then leave the block unchanged. */
+bool
+jx_bit_ring_buffer_snapshot_will_write(jx_bit_ring_buffer *buf, size_t bit_index);
+
+/* Return whether any snapshot of `buf` has not been freed yet. */
+bool
+jx_bit_ring_buffer_snapshot_state_is_in_use(jx_bit_ring_buffer *buf);
+
+/* Release the snapshot bookkeeping of `buf`. All snapshots must have been freed. */
+void
+jx_bit_ring_buffer_snapshot_state_free(jx_bit_ring_buffer *buf);
+
+#endif
+
+#endif /* LIBJX_DS_BIT_RING_BUFFER_SNAPSHOT_H */
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
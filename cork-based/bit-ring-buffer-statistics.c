@@ -0,0 +1,297 @@
+//
+//  bit-ring-buffer-statistics.c
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#include "bit-ring-buffer-statistics.h"
+
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+
+#include <string.h>
+
+
+#define JX_BIT_RING_BUFFER_BITS_PER_UNIT	(sizeof(size_t) * JX_BITSET_BITS_PER_BYTE)
+
+/* The builtins work on `unsigned long long`, which may be wider than `size_t`. */
+#define JX_BIT_RING_BUFFER_UNIT_PADDING_BITS \
+	((sizeof(unsigned long long) - sizeof(size_t)) * JX_BITSET_BITS_PER_BYTE)
+
+#define jx_unit_popcount(unit) \
+	((size_t)__builtin_popcountll((unsigned long long)(unit)))
+
+/* `unit` must not be 0. */
+#define jx_unit_count_trailing_zeros(unit) \
+	((size_t)__builtin_ctzll((unsigned long long)(unit)))
+#define jx_unit_count_leading_zeros(unit) \
+	((size_t)__builtin_clzll((unsigned long long)(unit)) - JX_BIT_RING_BUFFER_UNIT_PADDING_BITS)
+
+
+/* The state carried from one unit of the window to the next. */
+typedef struct jx_window_scan {
+	jx_bit_ring_buffer_window_statistics *statistics;
+	/* The last bit of the previous unit */
+	size_t  previous_bit;
+	/* The lengths of the runs of 0-bits and 1-bits that reach the end of the previous unit */
+	size_t  current_run[2];
+} jx_window_scan;
+
+
+static inline size_t
+mask_for_bit_count(size_t bit_count)
+{
+	return (bit_count < JX_BIT_RING_BUFFER_BITS_PER_UNIT) ? (((size_t)0b1 << bit_count) - 1) : ~(size_t)0;
+}
+
+/* Return the length of the longest run of 1-bits in `unit`.
+ * Every `unit &= unit >> 1` shortens each run by one bit. */
+static size_t
+longest_run_in_unit(size_t unit)
+{
+	size_t length = 0;
+	
+	while (unit != 0) {
+		unit &= unit >> 1;
+		length += 1;
+	}
+	
+	return length;
+}
+
+/* Extend the runs of 1-bits with the lowest `bit_count` bits of `unit`. */
+static void
+scan_runs(size_t unit, size_t bit_count, size_t *current_run, size_t *longest_run)
+{
+	if (unit == mask_for_bit_count(bit_count)) {
+		*current_run += bit_count;
+	}
+	else {
+		// The run at the bottom of the unit continues the one that reached the end of the previous unit.
+		*current_run += jx_unit_count_trailing_zeros(~unit);
+		if (*current_run > *longest_run) {
+			*longest_run = *current_run;
+		}
+		
+		// A run inside the unit can't be longer than the number of 1-bits in it.
+		if (jx_unit_popcount(unit) > *longest_run) {
+			const size_t run = longest_run_in_unit(unit);
+			if (run > *longest_run) {
+				*longest_run = run;
+			}
+		}
+		
+		// The run at the top of the unit may continue in the next one.
+		*current_run = jx_unit_count_leading_zeros(~(unit << (JX_BIT_RING_BUFFER_BITS_PER_UNIT - bit_count)));
+	}
+	
+	if (*current_run > *longest_run) {
+		*longest_run = *current_run;
+	}
+}
+
+/* Add the lowest `bit_count` bits of `unit` (at least one) to the scan. */
+static void
+scan_unit(jx_window_scan *scan, size_t unit, size_t bit_count)
+{
+	jx_bit_ring_buffer_window_statistics *statistics = scan->statistics;
+	const size_t mask = mask_for_bit_count(bit_count);
+	
+	// Line up every bit with the bit before it.
+	const size_t previous_bits = ((unit << 1) | scan->previous_bit) & mask;
+	const size_t inverted_unit = ~unit & mask;
+	
+	statistics->bit_count += bit_count;
+	statistics->one_count += jx_unit_popcount(unit);
+	statistics->rising_edge_count += jx_unit_popcount(unit & ~previous_bits);
+	statistics->falling_edge_count += jx_unit_popcount(inverted_unit & previous_bits);
+	
+	scan_runs(unit, bit_count, &scan->current_run[1], &statistics->longest_one_run);
+	scan_runs(inverted_unit, bit_count, &scan->current_run[0], &statistics->longest_zero_run);
+	
+	scan->previous_bit = (unit >> (bit_count - 1)) & 0b1;
+}
+
+static void
+scan_bits(jx_window_scan *scan, jx_bitset *set, size_t bit_offset, size_t bit_count)
+{
+	while (bit_count > 0) {
+		const size_t unit_bit_count = (bit_count < JX_BIT_RING_BUFFER_BITS_PER_UNIT) ? bit_count : JX_BIT_RING_BUFFER_BITS_PER_UNIT;
+		
+		scan_unit(scan, jx_bitset_get_bits(set, bit_offset, unit_bit_count), unit_bit_count);
+		
+		bit_offset += unit_bit_count;
+		bit_count -= unit_bit_count;
+	}
+}
+
+void
+jx_bit_ring_buffer_get_window_statistics(jx_bit_ring_buffer *buf, size_t bit_count,
+										 jx_bit_ring_buffer_window_statistics *statistics)
+{
+	memset(statistics, 0, sizeof(jx_bit_ring_buffer_window_statistics));
+	
+	if (bit_count > buf->used_bit_count) {
+		bit_count = buf->used_bit_count;
+	}
+	
+	if (bit_count == 0) {
+		return;
+	}
+	
+	const size_t allocated_size = jx_bit_ring_buffer_get_allocated_size(buf);
+	
+	// The newest `bit_count` bits start after the older bits that are left out.
+	size_t start_index = buf->read_index + (buf->used_bit_count - bit_count);
+	if (start_index >= allocated_size) {
+		start_index -= allocated_size;
+	}
+	
+	size_t first_part_bit_count = allocated_size - start_index;
+	if (first_part_bit_count > bit_count) {
+		first_part_bit_count = bit_count;
+	}
+	
+	// The oldest bit in the window has no bit before it: lining it up with itself counts no transition.
+	jx_window_scan scan = {
+		.statistics = statistics,
+		.previous_bit = jx_bitset_get(&buf->bitset, start_index) ? 0b1 : 0b0,
+		.current_run = { 0, 0 },
+	};
+	
+	// The part up to the end of the storage, then the part that wrapped around.
+	scan_bits(&scan, &buf->bitset, start_index, first_part_bit_count);
+	scan_bits(&scan, &buf->bitset, 0, bit_count - first_part_bit_count);
+}
+
+size_t
+jx_bit_ring_buffer_get_transition_count(jx_bit_ring_buffer *buf, size_t bit_count)
+{
+	jx_bit_ring_buffer_window_statistics statistics;
+	jx_bit_ring_buffer_get_window_statistics(buf, bit_count, &statistics);
+	
+	return statistics.rising_edge_count + statistics.falling_edge_count;
+}
+
+size_t
+jx_bit_ring_buffer_get_longest_run(jx_bit_ring_buffer *buf, size_t bit_count, bool element)
+{
+	jx_bit_ring_buffer_window_statistics statistics;
+	jx_bit_ring_buffer_get_window_statistics(buf, bit_count, &statistics);
+	
+	return element ? statistics.longest_one_run : statistics.longest_zero_run;
+}
+
+
+void
+jx_bit_ring_buffer_set_tracks_edges(jx_bit_ring_buffer *buf, bool tracks_edges)
+{
+	if (tracks_edges && !buf->tracks_edges) {
+		jx_bit_ring_buffer_window_statistics statistics;
+		jx_bit_ring_buffer_get_window_statistics(buf, buf->used_bit_count, &statistics);
+		
+		buf->rising_edge_count = statistics.rising_edge_count;
+		buf->falling_edge_count = statistics.falling_edge_count;
+	}
+	
+	buf->tracks_edges = tracks_edges;
+}
+
+static void
+update_edge_counts(jx_bit_ring_buffer *buf, bool from_element, bool to_element, bool is_added)
+{
+	if (from_element == to_element) {
+		return;
+	}
+	
+	size_t *edge_count = to_element ? &buf->rising_edge_count : &buf->falling_edge_count;
+	
+	if (is_added) {
+		*edge_count += 1;
+	}
+	else {
+		*edge_count -= 1;
+	}
+}
+
+/* Drop the transition between the oldest bit and the one after it. */
+static void
+drop_oldest_edge(jx_bit_ring_buffer *buf)
+{
+	if (buf->used_bit_count < 2) {
+		return;
+	}
+	
+	size_t next_index = buf->read_index + 1;
+	if (next_index == jx_bit_ring_buffer_get_allocated_size(buf)) {
+		next_index = 0;
+	}
+	
+	update_edge_counts(buf,
+					   jx_bitset_get(&buf->bitset, buf->read_index),
+					   jx_bitset_get(&buf->bitset, next_index),
+					   false);
+}
+
+void
+jx_bit_ring_buffer_statistics_will_add(jx_bit_ring_buffer *buf, bool element, bool replaces_oldest)
+{
+	size_t remaining_bit_count = buf->used_bit_count;
+	
+	if (replaces_oldest && (remaining_bit_count > 0)) {
+		drop_oldest_edge(buf);
+		remaining_bit_count -= 1;
+	}
+	
+	if (remaining_bit_count == 0) {
+		return;
+	}
+	
+	// When the buffer is full, the write index is the read index, so the newest bit is still intact.
+	const size_t write_index = (buf->write_index > 0) ? buf->write_index : jx_bit_ring_buffer_get_allocated_size(buf);
+	
+	update_edge_counts(buf, jx_bitset_get(&buf->bitset, write_index - 1), element, true);
+}
+
+void
+jx_bit_ring_buffer_statistics_will_pop(jx_bit_ring_buffer *buf)
+{
+	drop_oldest_edge(buf);
+}
+
+#endif
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
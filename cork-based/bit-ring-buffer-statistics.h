@@ -0,0 +1,117 @@
+//
+//  bit-ring-buffer-statistics.h
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#ifndef LIBJX_DS_BIT_RING_BUFFER_STATISTICS_H
+#define LIBJX_DS_BIT_RING_BUFFER_STATISTICS_H
+
+#include "bit-ring-buffer.h"
+
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+
+/*-----------------------------------------------------------------------
+ * Statistics over the newest bits of a bit ring buffer
+ *
+ * The window is scanned a `size_t` at a time, oldest bit first. Transitions
+ * come from comparing each unit with itself shifted by one bit, with the
+ * last bit of the previous unit shifted in, so they are counted across unit
+ * boundaries and across the seam where the window wraps around the storage.
+ * Runs are carried across those boundaries the same way.
+ *
+ * With edge tracking enabled, the edge counts over all stored bits are
+ * updated on every add and pop instead, and can be read without a scan.
+ */
+
+typedef struct jx_bit_ring_buffer_window_statistics {
+	/* The number of bits that were looked at */
+	size_t  bit_count;
+	size_t  one_count;
+	/* The number of 0→1 and 1→0 transitions between neighbouring bits */
+	size_t  rising_edge_count;
+	size_t  falling_edge_count;
+	/* The lengths of the longest runs of consecutive 1-bits and 0-bits */
+	size_t  longest_one_run;
+	size_t  longest_zero_run;
+} jx_bit_ring_buffer_window_statistics;
+
+
+/* Compute the statistics of the newest `bit_count` bits in `buf`,
+ * or of all bits in `buf` if it holds fewer than that. */
+void
+jx_bit_ring_buffer_get_window_statistics(jx_bit_ring_buffer *buf, size_t bit_count,
+										 jx_bit_ring_buffer_window_statistics *statistics);
+
+/* Return the number of transitions (in either direction) in the newest `bit_count` bits. */
+size_t
+jx_bit_ring_buffer_get_transition_count(jx_bit_ring_buffer *buf, size_t bit_count);
+
+/* Return the length of the longest run of `element` in the newest `bit_count` bits. */
+size_t
+jx_bit_ring_buffer_get_longest_run(jx_bit_ring_buffer *buf, size_t bit_count, bool element);
+
+
+/* Start or stop keeping the edge counts of `buf` up to date.
+ * Starting scans the bits that are already stored once. */
+void
+jx_bit_ring_buffer_set_tracks_edges(jx_bit_ring_buffer *buf, bool tracks_edges);
+
+/* Return the number of 0→1 and 1→0 transitions between all stored bits.
+ * These are only valid while `buf` tracks edges. */
+#define jx_bit_ring_buffer_get_rising_edge_count(buf) \
+	((buf)->rising_edge_count)
+#define jx_bit_ring_buffer_get_falling_edge_count(buf) \
+	((buf)->falling_edge_count)
+
+
+/* For the writer: update the edge counts for `element` about to be added.
+ * If `replaces_oldest`, the oldest bit is dropped first.
+ * Only call this if `buf` tracks edges. */
+void
+jx_bit_ring_buffer_statistics_will_add(jx_bit_ring_buffer *buf, bool element, bool replaces_oldest);
+
+/* For the reader: update the edge counts for the oldest bit about to be popped.
+ * Only call this if `buf` tracks edges and is not empty. */
+void
+jx_bit_ring_buffer_statistics_will_pop(jx_bit_ring_buffer *buf);
+
+#endif
+
+#endif /* LIBJX_DS_BIT_RING_BUFFER_STATISTICS_H */
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
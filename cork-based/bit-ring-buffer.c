@@ -10,6 +10,15 @@
 //
 
 #include "bit-ring-buffer.h"
+#include "instrumentation.h"
+
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+#include "bit-ring-buffer-snapshot.h"
+#endif
+
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+#include "bit-ring-buffer-statistics.h"
+#endif
 
 #include <stdlib.h>
 #include <stdbool.h>
@@ -27,7 +36,59 @@ jx_bit_ring_buffer_check_and_handle_index_wraparound(jx_bit_ring_buffer *self, s
 {
 	if (*index == jx_bit_ring_buffer_get_allocated_size(self)) {
 		*index = 0;
+		JX_INSTRUMENTATION_COUNT(ring_wraparounds, 1);
+	}
+}
+
+/* Return false if the bit at `index` must not be written. */
+static bool
+jx_bit_ring_buffer_will_write(jx_bit_ring_buffer *self, size_t index)
+{
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	if (self->snapshot_state != NULL) {
+		return jx_bit_ring_buffer_snapshot_will_write(self, index);
+	}
+#endif
+	
+	return true;
+}
+
+static void
+jx_bit_ring_buffer_set_bit(jx_bit_ring_buffer *self, size_t index, bool element)
+{
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	if (self->snapshot_state != NULL) {
+		// Snapshot readers may be loading this byte on other threads.
+		// See read_block() in bit-ring-buffer-snapshot.c.
+		uint8_t *byte_p = &jx_bitset_byte_for_bit(&self->bitset, index);
+		const uint8_t byte = (uint8_t)((*byte_p & jx_bitset_neg_mask_for_bit(index))
+									   | (element ? jx_bitset_pos_mask_for_bit(index) : 0));
+		__atomic_store_n(byte_p, byte, __ATOMIC_RELAXED);
+		return;
 	}
+#endif
+	
+	jx_bitset_set(&self->bitset, index, element);
+}
+
+static void
+jx_bit_ring_buffer_will_add(jx_bit_ring_buffer *self, bool element, bool replaces_oldest)
+{
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+	if (self->tracks_edges) {
+		jx_bit_ring_buffer_statistics_will_add(self, element, replaces_oldest);
+	}
+#endif
+}
+
+static void
+jx_bit_ring_buffer_will_pop(jx_bit_ring_buffer *self)
+{
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+	if (self->tracks_edges) {
+		jx_bit_ring_buffer_statistics_will_pop(self);
+	}
+#endif
 }
 
 
@@ -42,6 +103,16 @@ jx_bit_ring_buffer_init(jx_bit_ring_buffer *self, size_t bit_count)
 	self->read_index = 0;
 	self->write_index = 0;
 	
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	self->snapshot_state = NULL;
+#endif
+	
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+	self->tracks_edges = false;
+	self->rising_edge_count = 0;
+	self->falling_edge_count = 0;
+#endif
+	
 	return true;
 }
 
@@ -57,6 +128,9 @@ jx_bit_ring_buffer_new(size_t bit_count)
 void
 jx_bit_ring_buffer_done(jx_bit_ring_buffer *self)
 {
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	jx_bit_ring_buffer_snapshot_state_free(self);
+#endif
 	jx_bitset_done(&self->bitset);
 	//free(self->elements);
 }
@@ -72,37 +146,150 @@ bool
 jx_bit_ring_buffer_add(jx_bit_ring_buffer *self, bool element)
 {
 	if (jx_bit_ring_buffer_is_full(self)) {
+		JX_INSTRUMENTATION_COUNT(ring_failed_adds, 1);
 		return false;
 	}
 	
-	jx_bitset_set(&self->bitset, self->write_index, element);
+	if (!jx_bit_ring_buffer_will_write(self, self->write_index)) {
+		JX_INSTRUMENTATION_COUNT(ring_failed_adds, 1);
+		return false;
+	}
+	
+	jx_bit_ring_buffer_will_add(self, element, false);
+	jx_bit_ring_buffer_set_bit(self, self->write_index, element);
 	self->write_index += 1;
 	self->used_bit_count += 1;
 	
 	jx_bit_ring_buffer_check_and_handle_index_wraparound(self, &self->write_index);
+	
+	JX_INSTRUMENTATION_COUNT(ring_adds, 1);
 
 	return true;
 }
 
-void
+bool
 jx_bit_ring_buffer_add_with_overwrite(jx_bit_ring_buffer *self, bool element)
 {
-	jx_bitset_set(&self->bitset, self->write_index, element);
+	const bool was_full = jx_bit_ring_buffer_is_full(self);
+	
+	if (!jx_bit_ring_buffer_will_write(self, self->write_index)) {
+		JX_INSTRUMENTATION_COUNT(ring_failed_adds, 1);
+		return false;
+	}
+	
+	jx_bit_ring_buffer_will_add(self, element, was_full);
+	jx_bit_ring_buffer_set_bit(self, self->write_index, element);
 	self->write_index += 1;
 	jx_bit_ring_buffer_check_and_handle_index_wraparound(self, &self->write_index);
 	
-	if (!jx_bit_ring_buffer_is_full(self)) {
+	if (!was_full) {
 		self->used_bit_count += 1;
 	}
+	else {
+		// The oldest element was just overwritten, so the next one is now the oldest.
+		self->read_index += 1;
+		jx_bit_ring_buffer_check_and_handle_index_wraparound(self, &self->read_index);
+		
+		JX_INSTRUMENTATION_COUNT(ring_overwrites, 1);
+	}
+	
+	JX_INSTRUMENTATION_COUNT(ring_adds, 1);
+	
+	return true;
+}
+
+static bool
+jx_bit_ring_buffer_resize(jx_bit_ring_buffer *self, size_t bit_count)
+{
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	// Snapshots read the old storage in place.
+	if (jx_bit_ring_buffer_snapshot_state_is_in_use(self)) {
+		return false;
+	}
+	
+	// The block bookkeeping depends on the size of the storage.
+	jx_bit_ring_buffer_snapshot_state_free(self);
+#endif
+	
+	jx_bitset bitset;
+	jx_bitset_init(&bitset, bit_count);
+	
+	if (bitset.bits == NULL) {
+		return false;
+	}
+	
+	const size_t old_bit_count = jx_bit_ring_buffer_get_allocated_size(self);
+	const size_t used_bit_count = self->used_bit_count;
+	
+	// Relinearize the window: the part up to the end of the old storage, then the part that wrapped around.
+	size_t first_part_bit_count = old_bit_count - self->read_index;
+	if (first_part_bit_count > used_bit_count) {
+		first_part_bit_count = used_bit_count;
+	}
+	
+	jx_bitset_copy_bits(&bitset, 0, &self->bitset, self->read_index, first_part_bit_count);
+	jx_bitset_copy_bits(&bitset, first_part_bit_count, &self->bitset, 0, used_bit_count - first_part_bit_count);
+	
+	jx_bitset_done(&self->bitset);
+	jx_bitset_move(&self->bitset, &bitset);
+	
+	self->read_index = 0;
+	// Not a wraparound: a full buffer simply starts writing over its oldest bit at index 0.
+	self->write_index = used_bit_count % bit_count;
+	
+	JX_INSTRUMENTATION_COUNT(ring_resizes, 1);
+	
+	return true;
+}
+
+bool
+jx_bit_ring_buffer_reserve(jx_bit_ring_buffer *self, size_t bit_count)
+{
+	if (bit_count <= jx_bit_ring_buffer_get_allocated_size(self)) {
+		return true;
+	}
+	
+	return jx_bit_ring_buffer_resize(self, bit_count);
+}
+
+bool
+jx_bit_ring_buffer_shrink_to_fit(jx_bit_ring_buffer *self)
+{
+	const size_t bit_count = (self->used_bit_count > 0) ? self->used_bit_count : 1;
+	
+	if (bit_count == jx_bit_ring_buffer_get_allocated_size(self)) {
+		return true;
+	}
+	
+	return jx_bit_ring_buffer_resize(self, bit_count);
+}
+
+bool
+jx_bit_ring_buffer_add_with_growth(jx_bit_ring_buffer *self, bool element)
+{
+	if (jx_bit_ring_buffer_is_full(self)) {
+		const size_t allocated_size = jx_bit_ring_buffer_get_allocated_size(self);
+		const size_t bit_count = (allocated_size > 0) ? (allocated_size * 2) : 1;
+		
+		if (!jx_bit_ring_buffer_reserve(self, bit_count)) {
+			JX_INSTRUMENTATION_COUNT(ring_failed_adds, 1);
+			return false;
+		}
+	}
+	
+	return jx_bit_ring_buffer_add(self, element);
 }
 
 const bool *
 jx_bit_ring_buffer_pop(jx_bit_ring_buffer *self)
 {
 	if (jx_bit_ring_buffer_is_empty(self)) {
+		JX_INSTRUMENTATION_COUNT(ring_pops_on_empty, 1);
 		return NULL;
 	}
 	else {
+		JX_INSTRUMENTATION_COUNT(ring_pops, 1);
+		jx_bit_ring_buffer_will_pop(self);
 		bool result = jx_bitset_get(&self->bitset, self->read_index);
 		self->read_index += 1;
 		self->used_bit_count--;
@@ -15,6 +15,14 @@
 #include "bitset.h"
 
 
+#define JX_BIT_RING_BUFFER_USE_SNAPSHOTS 1
+/* The window statistics read whole units with jx_bitset_get_bits(). */
+#define JX_BIT_RING_BUFFER_USE_STATISTICS JX_BITSET_INVERT_BIT_ORDER
+
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+typedef struct jx_bit_ring_buffer_snapshot_state jx_bit_ring_buffer_snapshot_state;
+#endif
+
 typedef struct jx_bit_ring_buffer {
 	/* The elements of the bit ring buffer */
 	jx_bitset bitset;
@@ -24,6 +32,17 @@ typedef struct jx_bit_ring_buffer {
 	size_t  read_index;
 	/* The index of the next element to write into the buffer */
 	size_t  write_index;
+#if JX_BIT_RING_BUFFER_USE_SNAPSHOTS
+	/* Bookkeeping for read snapshots, NULL until the first snapshot is taken */
+	jx_bit_ring_buffer_snapshot_state *snapshot_state;
+#endif
+#if JX_BIT_RING_BUFFER_USE_STATISTICS
+	/* Whether the edge counts below are kept up to date on every add and pop */
+	bool    tracks_edges;
+	/* The number of 0→1 and 1→0 transitions between the stored bits, oldest to newest */
+	size_t  rising_edge_count;
+	size_t  falling_edge_count;
+#endif
 } jx_bit_ring_buffer;
 
 
@@ -52,9 +71,28 @@ jx_bit_ring_buffer_free(jx_bit_ring_buffer *buf);
 bool
 jx_bit_ring_buffer_add(jx_bit_ring_buffer *buf, bool element);
 
-void
+/* Add `element`, replacing the oldest bit if the buffer is full.
+ * Return false only if snapshots are in use and their copy of the
+ * affected bits could not be made. The buffer is unchanged then. */
+bool
 jx_bit_ring_buffer_add_with_overwrite(jx_bit_ring_buffer *buf, bool element);
 
+/* Add `element`, doubling the storage first if the buffer is full.
+ * Return false if the storage could not be grown. */
+bool
+jx_bit_ring_buffer_add_with_growth(jx_bit_ring_buffer *buf, bool element);
+
+/* Make sure the buffer can hold at least `bit_count` bits.
+ * Growing moves the bits to new storage, with the oldest bit at index 0.
+ * Return false if out of memory or if snapshots of the buffer are in use. */
+bool
+jx_bit_ring_buffer_reserve(jx_bit_ring_buffer *buf, size_t bit_count);
+
+/* Reduce the storage to the bits currently in use (but at least one).
+ * Return false if out of memory or if snapshots of the buffer are in use. */
+bool
+jx_bit_ring_buffer_shrink_to_fit(jx_bit_ring_buffer *buf);
+
 const bool *
 jx_bit_ring_buffer_pop(jx_bit_ring_buffer *buf);
 
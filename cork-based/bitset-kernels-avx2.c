@@ -0,0 +1,132 @@
+//
+//  bitset-kernels-avx2.c
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//  Compile with -mavx2 -mpopcnt. Without those flags, this file is empty.
+//
+
+#include "bitset-kernels.h"
+
+#include <stdint.h>
+
+#if defined(__AVX2__) && (SIZE_MAX == UINT64_MAX)
+
+#include <immintrin.h>
+
+
+/* Count the bits of each byte with two nibble lookups, then sum the bytes of each 64-bit lane.
+ * See Muła, Kurz, Lemire: “Faster Population Counts Using AVX2 Instructions”. */
+static inline __m256i
+popcount_lanes(__m256i v)
+{
+	const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+											0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low_mask = _mm256_set1_epi8(0x0f);
+	
+	const __m256i low = _mm256_and_si256(v, low_mask);
+	const __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+	const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+	
+	return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+static size_t
+popcount_units_avx2(size_t const *units, size_t unit_count)
+{
+	const size_t units_per_vector = sizeof(__m256i) / sizeof(size_t);
+	
+	__m256i sums = _mm256_setzero_si256();
+	size_t i = 0;
+	
+	for (; i + units_per_vector <= unit_count; i += units_per_vector) {
+		const __m256i v = _mm256_loadu_si256((const __m256i *)&(units[i]));
+		sums = _mm256_add_epi64(sums, popcount_lanes(v));
+	}
+	
+	size_t popcount = (size_t)(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+							   _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+	
+	for (; i < unit_count; i += 1) {
+		popcount += (size_t)_mm_popcnt_u64(units[i]);
+	}
+	
+	return popcount;
+}
+
+static size_t
+shift_units_forward_avx2(size_t *units, size_t unit_count, size_t prev_overflow)
+{
+	const size_t units_per_vector = sizeof(__m256i) / sizeof(size_t);
+	
+	// The previous vector, before shifting. Only its last lane is ever used.
+	__m256i previous = _mm256_set_epi64x((long long)(prev_overflow << 63), 0, 0, 0);
+	size_t i = 0;
+	
+	for (; i + units_per_vector <= unit_count; i += units_per_vector) {
+		__m256i *vector_p = (__m256i *)&(units[i]);
+		const __m256i v = _mm256_loadu_si256(vector_p);
+		
+		// Lanes [previous3, v0, v1, v2]: each lane’s lower neighbour.
+		const __m256i crossed = _mm256_permute2x128_si256(previous, v, 0x21);
+		const __m256i neighbours = _mm256_alignr_epi8(v, crossed, 8);
+		
+		const __m256i shifted = _mm256_or_si256(_mm256_slli_epi64(v, 1), _mm256_srli_epi64(neighbours, 63));
+		_mm256_storeu_si256(vector_p, shifted);
+		
+		previous = v;
+	}
+	
+	size_t unit_overflow = (size_t)_mm256_extract_epi64(previous, 3) >> 63;
+	
+	for (; i < unit_count; i += 1) {
+		const size_t unit = units[i];
+		units[i] = (unit << 1) | unit_overflow;
+		unit_overflow = unit >> 63;
+	}
+	
+	return unit_overflow;
+}
+
+const jx_bitset_kernels jx_bitset_kernels_avx2 = {
+	.name = "avx2",
+	.popcount_units = popcount_units_avx2,
+	.shift_units_forward = shift_units_forward_avx2,
+};
+
+#endif
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
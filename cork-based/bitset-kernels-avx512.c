@@ -0,0 +1,113 @@
+//
+//  bitset-kernels-avx512.c
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//  Compile with -mavx512f -mavx512vpopcntdq. Without those flags, this file is empty.
+//
+
+#include "bitset-kernels.h"
+
+#include <stdint.h>
+
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__) && (SIZE_MAX == UINT64_MAX)
+
+#include <immintrin.h>
+
+
+static size_t
+popcount_units_avx512(size_t const *units, size_t unit_count)
+{
+	const size_t units_per_vector = sizeof(__m512i) / sizeof(size_t);
+	
+	__m512i sums = _mm512_setzero_si512();
+	size_t i = 0;
+	
+	for (; i + units_per_vector <= unit_count; i += units_per_vector) {
+		const __m512i v = _mm512_loadu_si512(&(units[i]));
+		sums = _mm512_add_epi64(sums, _mm512_popcnt_epi64(v));
+	}
+	
+	// Leftover units are loaded through a mask, so no scalar loop is needed.
+	const __mmask8 mask = (__mmask8)((1u << (unit_count - i)) - 1);
+	const __m512i v = _mm512_maskz_loadu_epi64(mask, &(units[i]));
+	sums = _mm512_add_epi64(sums, _mm512_popcnt_epi64(v));
+	
+	return (size_t)_mm512_reduce_add_epi64(sums);
+}
+
+static size_t
+shift_units_forward_avx512(size_t *units, size_t unit_count, size_t prev_overflow)
+{
+	if (unit_count == 0) {
+		return prev_overflow;
+	}
+	
+	const size_t units_per_vector = sizeof(__m512i) / sizeof(size_t);
+	
+	// What gets shifted out is the top bit of the last unit, as it is now.
+	const size_t unit_overflow = units[unit_count - 1] >> 63;
+	
+	// The previous vector, before shifting. Only its last lane is ever used.
+	__m512i previous = _mm512_set_epi64((long long)(prev_overflow << 63), 0, 0, 0, 0, 0, 0, 0);
+	
+	for (size_t i = 0; i < unit_count; i += units_per_vector) {
+		const size_t remaining = unit_count - i;
+		const __mmask8 mask = (remaining < units_per_vector) ? (__mmask8)((1u << remaining) - 1) : (__mmask8)0xff;
+		
+		const __m512i v = _mm512_maskz_loadu_epi64(mask, &(units[i]));
+		
+		// Lanes [previous7, v0, …, v6]: each lane’s lower neighbour.
+		const __m512i neighbours = _mm512_alignr_epi64(v, previous, 7);
+		
+		const __m512i shifted = _mm512_or_si512(_mm512_slli_epi64(v, 1), _mm512_srli_epi64(neighbours, 63));
+		_mm512_mask_storeu_epi64(&(units[i]), mask, shifted);
+		
+		previous = v;
+	}
+	
+	return unit_overflow;
+}
+
+const jx_bitset_kernels jx_bitset_kernels_avx512 = {
+	.name = "avx512",
+	.popcount_units = popcount_units_avx512,
+	.shift_units_forward = shift_units_forward_avx512,
+};
+
+#endif
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
@@ -0,0 +1,114 @@
+//
+//  bitset-kernels-neon.c
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//  NEON is always available on AArch64. Elsewhere, this file is empty.
+//
+
+#include "bitset-kernels.h"
+
+#include <stdint.h>
+
+#if defined(__ARM_NEON) && defined(__aarch64__) && (SIZE_MAX == UINT64_MAX)
+
+#include <arm_neon.h>
+
+
+static size_t
+popcount_units_neon(size_t const *units, size_t unit_count)
+{
+	const size_t units_per_vector = sizeof(uint64x2_t) / sizeof(size_t);
+	
+	uint64x2_t sums = vdupq_n_u64(0);
+	size_t i = 0;
+	
+	for (; i + units_per_vector <= unit_count; i += units_per_vector) {
+		const uint8x16_t v = vreinterpretq_u8_u64(vld1q_u64((const uint64_t *)&(units[i])));
+		// Count per byte, then widen pairwise up to one sum per 64-bit lane.
+		sums = vaddq_u64(sums, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vcntq_u8(v)))));
+	}
+	
+	size_t popcount = (size_t)vaddvq_u64(sums);
+	
+	for (; i < unit_count; i += 1) {
+		popcount += (size_t)__builtin_popcountll(units[i]);
+	}
+	
+	return popcount;
+}
+
+static size_t
+shift_units_forward_neon(size_t *units, size_t unit_count, size_t prev_overflow)
+{
+	const size_t units_per_vector = sizeof(uint64x2_t) / sizeof(size_t);
+	
+	// The previous vector, before shifting. Only its last lane is ever used.
+	uint64x2_t previous = vcombine_u64(vdup_n_u64(0), vdup_n_u64((uint64_t)prev_overflow << 63));
+	size_t i = 0;
+	
+	for (; i + units_per_vector <= unit_count; i += units_per_vector) {
+		uint64_t *vector_p = (uint64_t *)&(units[i]);
+		const uint64x2_t v = vld1q_u64(vector_p);
+		
+		// Lanes [previous1, v0]: each lane’s lower neighbour.
+		const uint64x2_t neighbours = vextq_u64(previous, v, 1);
+		
+		vst1q_u64(vector_p, vorrq_u64(vshlq_n_u64(v, 1), vshrq_n_u64(neighbours, 63)));
+		
+		previous = v;
+	}
+	
+	size_t unit_overflow = (size_t)(vgetq_lane_u64(previous, 1) >> 63);
+	
+	for (; i < unit_count; i += 1) {
+		const size_t unit = units[i];
+		units[i] = (unit << 1) | unit_overflow;
+		unit_overflow = unit >> 63;
+	}
+	
+	return unit_overflow;
+}
+
+const jx_bitset_kernels jx_bitset_kernels_neon = {
+	.name = "neon",
+	.popcount_units = popcount_units_neon,
+	.shift_units_forward = shift_units_forward_neon,
+};
+
+#endif
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
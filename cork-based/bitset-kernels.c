@@ -0,0 +1,151 @@
+//
+//  bitset-kernels.c
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#include "bitset-kernels.h"
+
+#include "bitset.h"
+
+
+/*-----------------------------------------------------------------------
+ * Baseline kernels, for any CPU
+ */
+
+static size_t
+popcount_units_baseline(size_t const *units, size_t unit_count)
+{
+	size_t popcount = 0;
+	
+	for (size_t i = 0; i < unit_count; i += 1) {
+		popcount += __builtin_popcountll((unsigned long long)units[i]);
+	}
+	
+	return popcount;
+}
+
+static size_t
+shift_units_forward_baseline(size_t *units, size_t unit_count, size_t prev_overflow)
+{
+	const size_t last_bit_in_unit = sizeof(size_t) * JX_BITSET_BITS_PER_BYTE - 1;
+	
+	size_t unit_overflow = prev_overflow;
+	
+	for (size_t i = 0; i < unit_count; i += 1) {
+		size_t *unit_p = &(units[i]);
+		size_t unit = *unit_p;
+		*unit_p <<= 1;
+		*unit_p |= unit_overflow;
+		
+		unit_overflow = unit >> last_bit_in_unit;
+	}
+	
+	return unit_overflow;
+}
+
+const jx_bitset_kernels jx_bitset_kernels_baseline = {
+	.name = "baseline",
+	.popcount_units = popcount_units_baseline,
+	.shift_units_forward = shift_units_forward_baseline,
+};
+
+
+/*-----------------------------------------------------------------------
+ * Dispatch
+ */
+
+#if (JX_BITSET_HAVE_AVX2_KERNELS || JX_BITSET_HAVE_AVX512_KERNELS) && (defined(__x86_64__) || defined(__i386__))
+#define JX_BITSET_USE_CPU_SUPPORTS 1
+#endif
+
+size_t
+jx_bitset_get_supported_kernels(const jx_bitset_kernels **kernels, size_t max_count)
+{
+	const jx_bitset_kernels *supported[4];
+	size_t count = 0;
+	
+#if JX_BITSET_USE_CPU_SUPPORTS
+	__builtin_cpu_init();
+#endif
+	
+#if JX_BITSET_HAVE_AVX512_KERNELS
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq")) {
+		supported[count++] = &jx_bitset_kernels_avx512;
+	}
+#endif
+	
+#if JX_BITSET_HAVE_AVX2_KERNELS
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+		supported[count++] = &jx_bitset_kernels_avx2;
+	}
+#endif
+	
+#if JX_BITSET_HAVE_NEON_KERNELS
+	// NEON is part of every AArch64 CPU.
+	supported[count++] = &jx_bitset_kernels_neon;
+#endif
+	
+	supported[count++] = &jx_bitset_kernels_baseline;
+	
+	for (size_t i = 0; (i < count) && (i < max_count); i += 1) {
+		kernels[i] = supported[i];
+	}
+	
+	return count;
+}
+
+/* Until the constructor below has run, everybody gets the baseline. */
+static const jx_bitset_kernels *selected_kernels = &jx_bitset_kernels_baseline;
+
+__attribute__((constructor))
+static void
+jx_bitset_select_kernels(void)
+{
+	const jx_bitset_kernels *fastest;
+	jx_bitset_get_supported_kernels(&fastest, 1);
+	
+	selected_kernels = fastest;
+}
+
+const jx_bitset_kernels *
+jx_bitset_get_kernels(void)
+{
+	return selected_kernels;
+}
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
@@ -0,0 +1,94 @@
+//
+//  bitset-kernels.h
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#ifndef LIBJX_DS_BITSET_KERNELS_H
+#define LIBJX_DS_BITSET_KERNELS_H
+
+#include <stddef.h>
+
+
+/*-----------------------------------------------------------------------
+ * Bitset kernels
+ *
+ * The loops over whole units that dominate popcounts and shifts of large sets.
+ * Each instruction set variant lives in its own file, compiled with the flags
+ * for that instruction set. The fastest variant the CPU supports is selected
+ * once, when the library is loaded.
+ */
+
+typedef struct jx_bitset_kernels {
+	const char *name;
+	
+	/* Return the number of 1-bits in `units`. */
+	size_t
+	(*popcount_units)(size_t const *units, size_t unit_count);
+	
+	/* Shift every bit in `units` to the next index, shifting in `prev_overflow` (0 or 1) at index 0.
+	 * Return the bit shifted out of the last unit. */
+	size_t
+	(*shift_units_forward)(size_t *units, size_t unit_count, size_t prev_overflow);
+} jx_bitset_kernels;
+
+extern const jx_bitset_kernels jx_bitset_kernels_baseline;
+
+#if JX_BITSET_HAVE_AVX2_KERNELS
+extern const jx_bitset_kernels jx_bitset_kernels_avx2;
+#endif
+
+#if JX_BITSET_HAVE_AVX512_KERNELS
+extern const jx_bitset_kernels jx_bitset_kernels_avx512;
+#endif
+
+#if JX_BITSET_HAVE_NEON_KERNELS
+extern const jx_bitset_kernels jx_bitset_kernels_neon;
+#endif
+
+/* Return the kernels selected for this CPU. */
+const jx_bitset_kernels *
+jx_bitset_get_kernels(void);
+
+/* Return the number of kernel variants this CPU can run and store up to `max_count` of them,
+ * fastest first, in `kernels`. */
+size_t
+jx_bitset_get_supported_kernels(const jx_bitset_kernels **kernels, size_t max_count);
+
+#endif /* LIBJX_DS_BITSET_KERNELS_H */
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
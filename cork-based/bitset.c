@@ -13,6 +13,8 @@
 #include <string.h>
 
 #include "bitset.h"
+#include "bitset-kernels.h"
+#include "instrumentation.h"
 
 
 #if JX_BITSET_USE_INLINE_STORAGE
@@ -58,8 +60,13 @@ jx_bitset_init(jx_bitset *set, size_t bit_count)
 	if (bit_count > JX_BITSET_INLINE_STORAGE_COUNT)
 #endif
 	{
+#if JX_BITSET_USE_THREAD_POOL
+		// Start the storage on a cache line, so that the chunks of the parallel operations do, too.
+		void *bits = NULL;
+		set->bits = (posix_memalign(&bits, JX_BITSET_CACHE_LINE_SIZE, set->byte_count) == 0) ? bits : NULL;
+#else
 		set->bits = calloc(set->byte_count, sizeof(uint8_t));
-		
+#endif
 	}
 #if JX_BITSET_USE_INLINE_STORAGE
 	else {
@@ -67,7 +74,10 @@ jx_bitset_init(jx_bitset *set, size_t bit_count)
 	}
 #endif
 
-	jx_bitset_clear(set);
+	// Callers check `bits` to find out whether the allocation failed.
+	if (set->bits != NULL) {
+		jx_bitset_clear(set);
+	}
 }
 
 jx_bitset *
@@ -98,6 +108,18 @@ jx_bitset_free(jx_bitset *set)
 	free(set);
 }
 
+void
+jx_bitset_move(jx_bitset *dst, jx_bitset *src)
+{
+	*dst = *src;
+	
+#if JX_BITSET_USE_INLINE_STORAGE
+	if (jx_bitset_uses_inline_storage(src)) {
+		dst->bits = jx_bitset_uint8_pointer_for_inline_storage(dst);
+	}
+#endif
+}
+
 void
 jx_bitset_clear(jx_bitset *set)
 {
@@ -233,33 +255,32 @@ jx_bitset_shift_all_bits_forward_using_bytes(jx_bitset *set)
 	shift_bits_with_count(start_byte_p, last_byte_p, 0b0, bit_count);
 }
 
-void
-jx_bitset_shift_all_bits_forward_using_units(jx_bitset *set)
+#define JX_BITSET_BITS_PER_UNIT	(sizeof(size_t) * JX_BITSET_BITS_PER_BYTE)
+#define JX_BITSET_LAST_BIT_IN_UNIT	(JX_BITSET_BITS_PER_UNIT - 1)
+
+/* Return the bit that is shifted out of the top of `unit`. */
+#define jx_bitset_unit_overflow(unit) \
+	(((unit) & ((size_t)0b1 JX_BITSET_SINGLE_BIT_SHIFT JX_BITSET_LAST_BIT_IN_UNIT)) >> JX_BITSET_LAST_BIT_IN_UNIT)
+
+static size_t
+shift_units_with_count(size_t *units, const size_t unit_count, size_t prev_overflow)
+{
+	return jx_bitset_get_kernels()->shift_units_forward(units, unit_count, prev_overflow);
+}
+
+/* Shift the bytes following the whole units and clear the bits beyond `bit_count`. */
+static void
+finish_shift_after_units(jx_bitset *set, const size_t unit_count, const size_t unit_overflow)
 {
 	const size_t bit_count = jx_bitset_get_bit_count(set);
 	
 	const size_t unit_size = sizeof(size_t);
-	const size_t bits_per_unit = unit_size * JX_BITSET_BITS_PER_BYTE;
-	const size_t last_bit_in_unit = bits_per_unit - 1;
+	const size_t bits_per_unit = JX_BITSET_BITS_PER_UNIT;
 	
-	const size_t unit_count = set->byte_count / unit_size;
 	const size_t unit_remainder = set->byte_count % unit_size;
 	
-	const size_t unit_overflow_mask =
-	(size_t)0b1 JX_BITSET_SINGLE_BIT_SHIFT last_bit_in_unit;
-	
-	size_t unit_overflow = 0b0;
 	size_t *units = (size_t *)set->bits;
 	
-	for (size_t i = 0; i < unit_count; i += 1) {
-		size_t *unit_p = &(units[i]);
-		size_t unit = *unit_p;
-		*unit_p <<= 1;
-		*unit_p |= unit_overflow;
-		
-		unit_overflow = (unit & unit_overflow_mask) >> last_bit_in_unit;
-	}
-	
 	if (unit_remainder > 0) {
 		uint8_t *start_byte_p = (uint8_t *)&(units[unit_count]);
 		uint8_t *last_byte_p = &(set->bits[set->byte_count - 1]);
@@ -273,9 +294,25 @@ jx_bitset_shift_all_bits_forward_using_units(jx_bitset *set)
 	}
 }
 
+void
+jx_bitset_shift_all_bits_forward_using_units(jx_bitset *set)
+{
+	const size_t unit_count = set->byte_count / sizeof(size_t);
+	
+	size_t *units = (size_t *)set->bits;
+	
+	const size_t unit_overflow = shift_units_with_count(units, unit_count, 0b0);
+	
+	finish_shift_after_units(set, unit_count, unit_overflow);
+}
+
 void
 jx_bitset_shift_all_bits_forward(jx_bitset *set)
 {
+	JX_INSTRUMENTATION_COUNT(bitset_shift_calls, 1);
+	JX_INSTRUMENTATION_COUNT(bitset_shift_bits_scanned, jx_bitset_get_bit_count(set));
+	JX_INSTRUMENTATION_TIMER_START(start);
+	
 #if JX_BITSET_USE_INLINE_STORAGE
 	if (jx_bitset_uses_inline_storage(set)) {
 		set->bits_inline <<= 1;
@@ -291,10 +328,105 @@ jx_bitset_shift_all_bits_forward(jx_bitset *set)
 	{
 		jx_bitset_shift_all_bits_forward_using_units(set);
 	}
+	
+	JX_INSTRUMENTATION_TIMER_STOP(start, bitset_shift_cycles);
 }
 
 #endif
 
+#if JX_BITSET_INVERT_BIT_ORDER
+
+size_t
+jx_bitset_get_bits(jx_bitset *set, size_t bit_offset, size_t count)
+{
+	if (count == 0) {
+		return 0;
+	}
+	
+	size_t byte_index = jx_bitset_byte_offset_in_array(bit_offset);
+	const size_t end_byte_index = bytes_needed(bit_offset + count);
+	
+	size_t bits = set->bits[byte_index] >> jx_bitset_bit_offset_in_byte(bit_offset);
+	size_t filled_bit_count = JX_BITSET_BITS_PER_BYTE - jx_bitset_bit_offset_in_byte(bit_offset);
+	byte_index += 1;
+	
+	// A misaligned unit spans at most one byte more than an aligned one.
+	while ((filled_bit_count < count) && (byte_index < end_byte_index)) {
+		bits |= (size_t)set->bits[byte_index] << filled_bit_count;
+		filled_bit_count += JX_BITSET_BITS_PER_BYTE;
+		byte_index += 1;
+	}
+	
+	if (count < JX_BITSET_BITS_PER_UNIT) {
+		bits &= jx_bitset_get_mask_for_bits_below_power_of_two((size_t)1 << count);
+	}
+	
+	return bits;
+}
+
+void
+jx_bitset_set_bits(jx_bitset *set, size_t bit_offset, size_t bits, size_t count)
+{
+	size_t byte_index = jx_bitset_byte_offset_in_array(bit_offset);
+	size_t bit_offset_in_byte = jx_bitset_bit_offset_in_byte(bit_offset);
+	
+	while (count > 0) {
+		size_t bit_count_in_byte = JX_BITSET_BITS_PER_BYTE - bit_offset_in_byte;
+		if (count < bit_count_in_byte) {
+			bit_count_in_byte = count;
+		}
+		
+		const uint8_t mask = (uint8_t)(jx_bitset_get_mask_for_bits_below_power_of_two(1u << bit_count_in_byte) << bit_offset_in_byte);
+		uint8_t *byte_p = &(set->bits[byte_index]);
+		*byte_p = (*byte_p & ~mask) | ((uint8_t)(bits << bit_offset_in_byte) & mask);
+		
+		bits >>= bit_count_in_byte;
+		count -= bit_count_in_byte;
+		bit_offset_in_byte = 0;
+		byte_index += 1;
+	}
+}
+
+#endif
+
+void
+jx_bitset_copy_bits(jx_bitset *dst, size_t dst_offset, jx_bitset *src, size_t src_offset, size_t count)
+{
+#if JX_BITSET_INVERT_BIT_ORDER
+	const size_t bits_per_unit = JX_BITSET_BITS_PER_UNIT;
+	
+	// Align the destination to a byte, so that whole units can be stored byte by byte.
+	size_t head_count = (JX_BITSET_BITS_PER_BYTE - jx_bitset_bit_offset_in_byte(dst_offset)) % JX_BITSET_BITS_PER_BYTE;
+	if (head_count > count) {
+		head_count = count;
+	}
+	
+	jx_bitset_set_bits(dst, dst_offset, jx_bitset_get_bits(src, src_offset, head_count), head_count);
+	dst_offset += head_count;
+	src_offset += head_count;
+	count -= head_count;
+	
+	while (count >= bits_per_unit) {
+		size_t unit = jx_bitset_get_bits(src, src_offset, bits_per_unit);
+		uint8_t *byte_p = &jx_bitset_byte_for_bit(dst, dst_offset);
+		
+		for (size_t i = 0; i < sizeof(size_t); i += 1) {
+			byte_p[i] = (uint8_t)(unit >> (i * JX_BITSET_BITS_PER_BYTE));
+		}
+		
+		dst_offset += bits_per_unit;
+		src_offset += bits_per_unit;
+		count -= bits_per_unit;
+	}
+	
+	jx_bitset_set_bits(dst, dst_offset, jx_bitset_get_bits(src, src_offset, count), count);
+#else
+	for (size_t i = 0; i < count; i += 1) {
+		jx_bitset_set(dst, dst_offset + i, jx_bitset_get(src, src_offset + i));
+	}
+#endif
+}
+
 void
 jx_bitset_shift_all_bits_forward_slowest(jx_bitset *set)
 {
@@ -310,8 +442,30 @@ jx_bitset_shift_all_bits_forward_slowest(jx_bitset *set)
 	}
 }
 
-size_t
-jx_bitset_popcount(jx_bitset *set)
+static size_t
+popcount_units(size_t const *units, const size_t unit_count)
+{
+	return jx_bitset_get_kernels()->popcount_units(units, unit_count);
+}
+
+static size_t
+popcount_bytes_after_units(jx_bitset *set, const size_t unit_count, const size_t unit_remainder)
+{
+	size_t popcount = 0;
+	
+	if (unit_remainder > 0) {
+		uint8_t const *start_byte_p = (uint8_t *)&(((size_t *)set->bits)[unit_count]);
+		for (size_t i = 0; i < unit_remainder; i += 1) {
+			uint8_t const *byte_p = &(start_byte_p[i]);
+			popcount += jx_bitset_generic_popcount(*byte_p);
+		}
+	}
+	
+	return popcount;
+}
+
+static size_t
+popcount_of_set(jx_bitset *set)
 {
 #if JX_BITSET_USE_INLINE_STORAGE
 	if (jx_bitset_uses_inline_storage(set)) {
@@ -325,26 +479,242 @@ jx_bitset_popcount(jx_bitset *set)
 		const size_t unit_count = set->byte_count / unit_size;
 		const size_t unit_remainder = set->byte_count % unit_size;
 		
-		size_t popcount = 0;
 		size_t const *units = (size_t *)set->bits;
 		
-		for (size_t i = 0; i < unit_count; i += 1) {
-			size_t const *unit_p = &(units[i]);
-			popcount += jx_bitset_generic_popcount(*unit_p);
-		}
+		size_t popcount = popcount_units(units, unit_count);
 		
-		if (unit_remainder > 0) {
-			uint8_t *start_byte_p = (uint8_t *)&(units[unit_count]);
-			for (size_t i = 0; i < unit_remainder; i += 1) {
-				uint8_t const *byte_p = &(start_byte_p[i]);
-				popcount += jx_bitset_generic_popcount(*byte_p);
-			}
-		}
+		popcount += popcount_bytes_after_units(set, unit_count, unit_remainder);
 		
 		return popcount;
 	}
 }
 
+size_t
+jx_bitset_popcount(jx_bitset *set)
+{
+	JX_INSTRUMENTATION_COUNT(bitset_popcount_calls, 1);
+	JX_INSTRUMENTATION_COUNT(bitset_popcount_bits_scanned, jx_bitset_get_bit_count(set));
+	JX_INSTRUMENTATION_TIMER_START(start);
+	
+	const size_t popcount = popcount_of_set(set);
+	
+	JX_INSTRUMENTATION_TIMER_STOP(start, bitset_popcount_cycles);
+	
+	return popcount;
+}
+
+#if JX_BITSET_USE_THREAD_POOL
+
+#define JX_BITSET_UNITS_PER_CACHE_LINE	(JX_BITSET_CACHE_LINE_SIZE / sizeof(size_t))
+
+/* The whole units of a set, split into one cache-line-aligned chunk per thread.
+ * The bytes following the last whole unit are left to the calling thread. */
+typedef struct jx_bitset_chunks {
+	size_t *units;
+	size_t  unit_count;
+	size_t  units_per_chunk;
+	size_t  chunk_count;
+} jx_bitset_chunks;
+
+static bool
+jx_bitset_should_run_in_parallel(jx_bitset *set, jx_thread_pool *pool)
+{
+	if ((pool == NULL) || (jx_thread_pool_get_thread_count(pool) < 2)) {
+		return false;
+	}
+	
+#if JX_BITSET_USE_INLINE_STORAGE
+	if (jx_bitset_uses_inline_storage(set)) {
+		return false;
+	}
+#endif
+	
+	return (set->byte_count >= JX_BITSET_PARALLEL_MIN_BYTE_COUNT);
+}
+
+static void
+jx_bitset_chunks_init(jx_bitset_chunks *chunks, jx_bitset *set, jx_thread_pool *pool)
+{
+	const size_t thread_count = jx_thread_pool_get_thread_count(pool);
+	
+	chunks->units = (size_t *)set->bits;
+	chunks->unit_count = set->byte_count / sizeof(size_t);
+	
+	// The storage starts on a cache line. Rounding up to whole cache lines
+	// keeps every chunk on its own lines, so that no two threads write to the same line.
+	size_t units_per_chunk = (chunks->unit_count + thread_count - 1) / thread_count;
+	units_per_chunk += JX_BITSET_UNITS_PER_CACHE_LINE - 1;
+	units_per_chunk -= units_per_chunk % JX_BITSET_UNITS_PER_CACHE_LINE;
+	
+	chunks->units_per_chunk = units_per_chunk;
+	chunks->chunk_count = (chunks->unit_count + units_per_chunk - 1) / units_per_chunk;
+}
+
+static size_t
+jx_bitset_chunks_get_start(const jx_bitset_chunks *chunks, size_t chunk_index)
+{
+	return chunk_index * chunks->units_per_chunk;
+}
+
+static size_t
+jx_bitset_chunks_get_length(const jx_bitset_chunks *chunks, size_t chunk_index)
+{
+	const size_t start = jx_bitset_chunks_get_start(chunks, chunk_index);
+	const size_t remaining = chunks->unit_count - start;
+	
+	return (remaining < chunks->units_per_chunk) ? remaining : chunks->units_per_chunk;
+}
+
+
+typedef struct jx_bitset_popcount_job {
+	jx_bitset_chunks chunks;
+	size_t *popcounts;
+} jx_bitset_popcount_job;
+
+static void
+jx_bitset_popcount_chunk(void *context, size_t chunk_index)
+{
+	jx_bitset_popcount_job *job = context;
+	
+	const size_t start = jx_bitset_chunks_get_start(&job->chunks, chunk_index);
+	const size_t length = jx_bitset_chunks_get_length(&job->chunks, chunk_index);
+	
+	// Only a single store per chunk, so neighbouring partial results don’t bounce cache lines around.
+	job->popcounts[chunk_index] = popcount_units(&(job->chunks.units[start]), length);
+}
+
+size_t
+jx_bitset_popcount_parallel(jx_bitset *set, jx_thread_pool *pool)
+{
+	if (!jx_bitset_should_run_in_parallel(set, pool)) {
+		return jx_bitset_popcount(set);
+	}
+	
+	jx_bitset_popcount_job job;
+	jx_bitset_chunks_init(&job.chunks, set, pool);
+	
+	job.popcounts = calloc(job.chunks.chunk_count, sizeof(size_t));
+	if (job.popcounts == NULL) {
+		return jx_bitset_popcount(set);
+	}
+	
+	JX_INSTRUMENTATION_COUNT(bitset_popcount_calls, 1);
+	JX_INSTRUMENTATION_COUNT(bitset_popcount_bits_scanned, jx_bitset_get_bit_count(set));
+	JX_INSTRUMENTATION_TIMER_START(start);
+	
+	jx_thread_pool_run(pool, jx_bitset_popcount_chunk, &job, job.chunks.chunk_count);
+	
+	size_t popcount = 0;
+	
+	for (size_t i = 0; i < job.chunks.chunk_count; i += 1) {
+		popcount += job.popcounts[i];
+	}
+	
+	free(job.popcounts);
+	
+	const size_t unit_remainder = set->byte_count % sizeof(size_t);
+	popcount += popcount_bytes_after_units(set, job.chunks.unit_count, unit_remainder);
+	
+	JX_INSTRUMENTATION_TIMER_STOP(start, bitset_popcount_cycles);
+	
+	return popcount;
+}
+
+#if JX_BITSET_INVERT_BIT_ORDER
+
+static void
+jx_bitset_set_chunk_to_true(void *context, size_t chunk_index)
+{
+	jx_bitset_chunks *chunks = context;
+	
+	const size_t start = jx_bitset_chunks_get_start(chunks, chunk_index);
+	const size_t length = jx_bitset_chunks_get_length(chunks, chunk_index);
+	
+	memset(&(chunks->units[start]), JX_BITSET_BYTE_WITH_ALL_BITS_SET, length * sizeof(size_t));
+}
+
+void
+jx_bitset_set_all_to_true_parallel(jx_bitset *set, jx_thread_pool *pool)
+{
+	if (!jx_bitset_should_run_in_parallel(set, pool)) {
+		jx_bitset_set_all_to_true(set);
+		return;
+	}
+	
+	jx_bitset_chunks chunks;
+	jx_bitset_chunks_init(&chunks, set, pool);
+	
+	jx_thread_pool_run(pool, jx_bitset_set_chunk_to_true, &chunks, chunks.chunk_count);
+	
+	const size_t unit_byte_count = chunks.unit_count * sizeof(size_t);
+	memset(&(set->bits[unit_byte_count]), JX_BITSET_BYTE_WITH_ALL_BITS_SET, set->byte_count - unit_byte_count);
+	
+	const uint8_t last_byte_mask = last_byte_mask_for_bit_count(jx_bitset_get_bit_count(set));
+	set->bits[set->byte_count - 1] &= last_byte_mask;
+}
+
+
+typedef struct jx_bitset_shift_job {
+	jx_bitset_chunks chunks;
+	/* The bit shifted into the first unit of each chunk. */
+	size_t *overflows;
+} jx_bitset_shift_job;
+
+static void
+jx_bitset_shift_chunk(void *context, size_t chunk_index)
+{
+	jx_bitset_shift_job *job = context;
+	
+	const size_t start = jx_bitset_chunks_get_start(&job->chunks, chunk_index);
+	const size_t length = jx_bitset_chunks_get_length(&job->chunks, chunk_index);
+	
+	shift_units_with_count(&(job->chunks.units[start]), length, job->overflows[chunk_index]);
+}
+
+void
+jx_bitset_shift_all_bits_forward_parallel(jx_bitset *set, jx_thread_pool *pool)
+{
+	if (!jx_bitset_should_run_in_parallel(set, pool)) {
+		jx_bitset_shift_all_bits_forward(set);
+		return;
+	}
+	
+	jx_bitset_shift_job job;
+	jx_bitset_chunks_init(&job.chunks, set, pool);
+	
+	// One extra slot for the overflow out of the last whole unit.
+	job.overflows = calloc(job.chunks.chunk_count + 1, sizeof(size_t));
+	if (job.overflows == NULL) {
+		jx_bitset_shift_all_bits_forward(set);
+		return;
+	}
+	
+	JX_INSTRUMENTATION_COUNT(bitset_shift_calls, 1);
+	JX_INSTRUMENTATION_COUNT(bitset_shift_bits_scanned, jx_bitset_get_bit_count(set));
+	JX_INSTRUMENTATION_TIMER_START(start);
+	
+	// Collect the boundary bits before any chunk is shifted:
+	// each chunk receives the top bit of the last unit of the chunk before it.
+	job.overflows[0] = 0b0;
+	for (size_t i = 1; i <= job.chunks.chunk_count; i += 1) {
+		const size_t last_unit_of_previous_chunk =
+		jx_bitset_chunks_get_start(&job.chunks, i - 1) + jx_bitset_chunks_get_length(&job.chunks, i - 1) - 1;
+		job.overflows[i] = jx_bitset_unit_overflow(job.chunks.units[last_unit_of_previous_chunk]);
+	}
+	
+	jx_thread_pool_run(pool, jx_bitset_shift_chunk, &job, job.chunks.chunk_count);
+	
+	finish_shift_after_units(set, job.chunks.unit_count, job.overflows[job.chunks.chunk_count]);
+	
+	JX_INSTRUMENTATION_TIMER_STOP(start, bitset_shift_cycles);
+	
+	free(job.overflows);
+}
+
+#endif
+
+#endif
+
 /*
  Copyright 2011-2013, RedJack, LLC.
  Copyright 2017 Jan Weiß
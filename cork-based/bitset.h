@@ -14,6 +14,8 @@
 
 #include <limits.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 
 /*-----------------------------------------------------------------------
@@ -23,6 +25,7 @@
 #define JX_BITSET_BITS_PER_BYTE	8
 #define JX_BITSET_INVERT_BIT_ORDER 1
 #define JX_BITSET_USE_INLINE_STORAGE 1
+#define JX_BITSET_USE_THREAD_POOL 1
 
 #define JX_BITSET_INLINE_STORAGE_SIZE (sizeof(size_t))
 #define JX_BITSET_INLINE_STORAGE_COUNT (JX_BITSET_INLINE_STORAGE_SIZE * JX_BITSET_BITS_PER_BYTE)
@@ -62,6 +65,28 @@ void
 jx_bitset_shift_all_bits_forward(jx_bitset *set);
 #endif
 
+/* Move the storage of `src` into `dst`, which must not own any storage.
+ * `src` must not be used (or done) afterwards. This takes care of sets using inline storage,
+ * which can’t simply be copied by assignment. */
+void
+jx_bitset_move(jx_bitset *dst, jx_bitset *src);
+
+/* Copy `count` bits starting at `src_offset` in `src` to `dst`, starting at `dst_offset`.
+ * The sets must not be the same. */
+void
+jx_bitset_copy_bits(jx_bitset *dst, size_t dst_offset, jx_bitset *src, size_t src_offset, size_t count);
+
+#if JX_BITSET_INVERT_BIT_ORDER
+/* Return up to a `size_t` worth of bits starting at `bit_offset`,
+ * with bit `bit_offset` in the least significant position. */
+size_t
+jx_bitset_get_bits(jx_bitset *set, size_t bit_offset, size_t count);
+
+/* Store the lowest `count` bits of `bits` starting at `bit_offset`. */
+void
+jx_bitset_set_bits(jx_bitset *set, size_t bit_offset, size_t bits, size_t count);
+#endif
+
 /* Shift every bit to the next index. 
  * The first bit (index 0) is set to `false`.
  * The last bit’s value is lost. */
@@ -72,6 +97,29 @@ jx_bitset_shift_all_bits_forward_slowest(jx_bitset *set);
 size_t
 jx_bitset_popcount(jx_bitset *set);
 
+#if JX_BITSET_USE_THREAD_POOL
+#include "thread-pool.h"
+
+#define JX_BITSET_CACHE_LINE_SIZE	64
+
+/* Sets smaller than this are not worth waking up the pool for. */
+#define JX_BITSET_PARALLEL_MIN_BYTE_COUNT	(64 * 1024)
+
+/* Parallel variants of the whole-set operations above.
+ * The set is split into cache-line-aligned chunks, one for each thread of `pool`.
+ * Small sets, inline sets and a NULL `pool` are handled on the calling thread. */
+size_t
+jx_bitset_popcount_parallel(jx_bitset *set, jx_thread_pool *pool);
+
+#if JX_BITSET_INVERT_BIT_ORDER
+void
+jx_bitset_set_all_to_true_parallel(jx_bitset *set, jx_thread_pool *pool);
+
+void
+jx_bitset_shift_all_bits_forward_parallel(jx_bitset *set, jx_thread_pool *pool);
+#endif
+#endif
+
 /* Calculate the offset of the byte for a particular bit within the byte array. */
 #define jx_bitset_byte_offset_in_array(i) \
 	((i) / JX_BITSET_BITS_PER_BYTE)
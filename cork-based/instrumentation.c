@@ -0,0 +1,116 @@
+//
+//  instrumentation.c
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#include "instrumentation.h"
+
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+
+#if JX_INSTRUMENTATION
+_Thread_local jx_instrumentation_counters jx_instrumentation_thread_counters;
+#endif
+
+void
+jx_instrumentation_get_counters(jx_instrumentation_counters *counters)
+{
+#if JX_INSTRUMENTATION
+	*counters = jx_instrumentation_thread_counters;
+#else
+	memset(counters, 0, sizeof(jx_instrumentation_counters));
+#endif
+}
+
+void
+jx_instrumentation_reset(void)
+{
+#if JX_INSTRUMENTATION
+	memset(&jx_instrumentation_thread_counters, 0, sizeof(jx_instrumentation_counters));
+#endif
+}
+
+void
+jx_instrumentation_dump(FILE *stream)
+{
+	jx_instrumentation_counters counters;
+	jx_instrumentation_get_counters(&counters);
+	
+#define JX_INSTRUMENTATION_PRINT(counter) \
+	fprintf(stream, "%-30s %20" PRIu64 "\n", #counter, counters.counter)
+	
+	JX_INSTRUMENTATION_PRINT(ring_adds);
+	JX_INSTRUMENTATION_PRINT(ring_failed_adds);
+	JX_INSTRUMENTATION_PRINT(ring_overwrites);
+	JX_INSTRUMENTATION_PRINT(ring_pops);
+	JX_INSTRUMENTATION_PRINT(ring_pops_on_empty);
+	JX_INSTRUMENTATION_PRINT(ring_wraparounds);
+	JX_INSTRUMENTATION_PRINT(ring_resizes);
+	JX_INSTRUMENTATION_PRINT(bitset_popcount_calls);
+	JX_INSTRUMENTATION_PRINT(bitset_popcount_bits_scanned);
+	JX_INSTRUMENTATION_PRINT(bitset_popcount_cycles);
+	JX_INSTRUMENTATION_PRINT(bitset_shift_calls);
+	JX_INSTRUMENTATION_PRINT(bitset_shift_bits_scanned);
+	JX_INSTRUMENTATION_PRINT(bitset_shift_cycles);
+	
+#undef JX_INSTRUMENTATION_PRINT
+}
+
+uint64_t
+jx_instrumentation_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#elif defined(__aarch64__)
+	uint64_t ticks;
+	__asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (ticks));
+	return ticks;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
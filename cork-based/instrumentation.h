@@ -0,0 +1,131 @@
+//
+//  instrumentation.h
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#ifndef LIBJX_INSTRUMENTATION_H
+#define LIBJX_INSTRUMENTATION_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+/*-----------------------------------------------------------------------
+ * Hot-path instrumentation
+ *
+ * Build with -DJX_INSTRUMENTATION=1 to count what the bitset and ring buffer
+ * operations do. Counters are kept per thread, so they cost no synchronization;
+ * work done by the workers of a thread pool is counted for the calling thread.
+ * Build with -DJX_INSTRUMENTATION_CYCLES=1 as well to time popcounts and shifts.
+ * When disabled, the counting macros expand to nothing and all counters read as 0.
+ */
+
+#ifndef JX_INSTRUMENTATION
+#define JX_INSTRUMENTATION 0
+#endif
+
+#ifndef JX_INSTRUMENTATION_CYCLES
+#define JX_INSTRUMENTATION_CYCLES 0
+#endif
+
+typedef struct jx_instrumentation_counters {
+	/* Successful adds, with or without overwrite */
+	uint64_t ring_adds;
+	/* Adds rejected because the ring was full, or because a snapshot block could not be copied */
+	uint64_t ring_failed_adds;
+	/* Adds that replaced the oldest bit of a full ring */
+	uint64_t ring_overwrites;
+	uint64_t ring_pops;
+	uint64_t ring_pops_on_empty;
+	/* Read or write index moving from the end of the storage back to 0 */
+	uint64_t ring_wraparounds;
+	/* Storage reallocations by reserve, grow or shrink */
+	uint64_t ring_resizes;
+	
+	uint64_t bitset_popcount_calls;
+	uint64_t bitset_popcount_bits_scanned;
+	uint64_t bitset_popcount_cycles;
+	
+	uint64_t bitset_shift_calls;
+	uint64_t bitset_shift_bits_scanned;
+	uint64_t bitset_shift_cycles;
+} jx_instrumentation_counters;
+
+/* Copy the counters of the calling thread. */
+void
+jx_instrumentation_get_counters(jx_instrumentation_counters *counters);
+
+/* Reset the counters of the calling thread to 0. */
+void
+jx_instrumentation_reset(void);
+
+/* Print the counters of the calling thread. */
+void
+jx_instrumentation_dump(FILE *stream);
+
+/* Return a timestamp in cycles (or the finest unit the platform offers). */
+uint64_t
+jx_instrumentation_cycles(void);
+
+#if JX_INSTRUMENTATION
+extern _Thread_local jx_instrumentation_counters jx_instrumentation_thread_counters;
+
+#define JX_INSTRUMENTATION_COUNT(counter, n) \
+	((void)(jx_instrumentation_thread_counters.counter += (n)))
+#else
+#define JX_INSTRUMENTATION_COUNT(counter, n) \
+	((void)0)
+#endif
+
+#if JX_INSTRUMENTATION && JX_INSTRUMENTATION_CYCLES
+#define JX_INSTRUMENTATION_TIMER_START(timer) \
+	const uint64_t timer = jx_instrumentation_cycles()
+
+#define JX_INSTRUMENTATION_TIMER_STOP(timer, counter) \
+	JX_INSTRUMENTATION_COUNT(counter, jx_instrumentation_cycles() - (timer))
+#else
+#define JX_INSTRUMENTATION_TIMER_START(timer) \
+	((void)0)
+
+#define JX_INSTRUMENTATION_TIMER_STOP(timer, counter) \
+	((void)0)
+#endif
+
+#endif /* LIBJX_INSTRUMENTATION_H */
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
@@ -0,0 +1,242 @@
+//
+//  thread-pool.c
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#include "thread-pool.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+struct jx_thread_pool {
+	pthread_mutex_t lock;
+	/* Signalled when a new run starts or the pool shuts down. */
+	pthread_cond_t  run_started;
+	/* Signalled when the last worker has left the current run. */
+	pthread_cond_t  run_finished;
+	
+	pthread_t *workers;
+	size_t  worker_count;
+	
+	/* The current run. */
+	jx_thread_pool_task task;
+	void   *context;
+	size_t  task_count;
+	size_t  next_task_index;
+	size_t  busy_worker_count;
+	/* Incremented for every run, so that workers can tell runs apart. */
+	size_t  generation;
+	
+	bool    shutting_down;
+};
+
+
+static bool
+jx_thread_pool_claim_task(jx_thread_pool *pool, size_t *task_index)
+{
+	bool claimed = false;
+	
+	pthread_mutex_lock(&pool->lock);
+	if (pool->next_task_index < pool->task_count) {
+		*task_index = pool->next_task_index;
+		pool->next_task_index += 1;
+		claimed = true;
+	}
+	pthread_mutex_unlock(&pool->lock);
+	
+	return claimed;
+}
+
+static void
+jx_thread_pool_work_on_current_run(jx_thread_pool *pool)
+{
+	size_t task_index;
+	
+	// `task` and `context` only change while no worker is busy.
+	while (jx_thread_pool_claim_task(pool, &task_index)) {
+		pool->task(pool->context, task_index);
+	}
+}
+
+static void *
+jx_thread_pool_worker_main(void *arg)
+{
+	jx_thread_pool *pool = arg;
+	size_t seen_generation = 0;
+	
+	pthread_mutex_lock(&pool->lock);
+	
+	while (true) {
+		while (!pool->shutting_down && (pool->generation == seen_generation)) {
+			pthread_cond_wait(&pool->run_started, &pool->lock);
+		}
+		
+		if (pool->shutting_down) {
+			break;
+		}
+		
+		seen_generation = pool->generation;
+		pthread_mutex_unlock(&pool->lock);
+		
+		jx_thread_pool_work_on_current_run(pool);
+		
+		pthread_mutex_lock(&pool->lock);
+		pool->busy_worker_count -= 1;
+		if (pool->busy_worker_count == 0) {
+			pthread_cond_signal(&pool->run_finished);
+		}
+	}
+	
+	pthread_mutex_unlock(&pool->lock);
+	
+	return NULL;
+}
+
+static size_t
+online_processor_count(void)
+{
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	
+	return (count > 0) ? (size_t)count : 1;
+}
+
+static void
+jx_thread_pool_stop_workers(jx_thread_pool *pool, size_t started_worker_count)
+{
+	pthread_mutex_lock(&pool->lock);
+	pool->shutting_down = true;
+	pthread_cond_broadcast(&pool->run_started);
+	pthread_mutex_unlock(&pool->lock);
+	
+	for (size_t i = 0; i < started_worker_count; i += 1) {
+		pthread_join(pool->workers[i], NULL);
+	}
+}
+
+jx_thread_pool *
+jx_thread_pool_new(size_t thread_count)
+{
+	if (thread_count == 0) {
+		thread_count = online_processor_count();
+	}
+	
+	jx_thread_pool *pool = calloc(1, sizeof(jx_thread_pool));
+	if (pool == NULL) {
+		return NULL;
+	}
+	
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->run_started, NULL);
+	pthread_cond_init(&pool->run_finished, NULL);
+	
+	// The calling thread is the first member of the pool.
+	pool->worker_count = thread_count - 1;
+	
+	if (pool->worker_count > 0) {
+		pool->workers = calloc(pool->worker_count, sizeof(pthread_t));
+		if (pool->workers == NULL) {
+			pool->worker_count = 0;
+			jx_thread_pool_free(pool);
+			return NULL;
+		}
+	}
+	
+	for (size_t i = 0; i < pool->worker_count; i += 1) {
+		if (pthread_create(&pool->workers[i], NULL, jx_thread_pool_worker_main, pool) != 0) {
+			jx_thread_pool_stop_workers(pool, i);
+			pool->worker_count = 0;
+			jx_thread_pool_free(pool);
+			return NULL;
+		}
+	}
+	
+	return pool;
+}
+
+void
+jx_thread_pool_free(jx_thread_pool *pool)
+{
+	jx_thread_pool_stop_workers(pool, pool->worker_count);
+	
+	pthread_cond_destroy(&pool->run_finished);
+	pthread_cond_destroy(&pool->run_started);
+	pthread_mutex_destroy(&pool->lock);
+	
+	free(pool->workers);
+	free(pool);
+}
+
+size_t
+jx_thread_pool_get_thread_count(jx_thread_pool *pool)
+{
+	return pool->worker_count + 1;
+}
+
+void
+jx_thread_pool_run(jx_thread_pool *pool, jx_thread_pool_task task, void *context, size_t task_count)
+{
+	if ((pool->worker_count == 0) || (task_count <= 1)) {
+		for (size_t i = 0; i < task_count; i += 1) {
+			task(context, i);
+		}
+		
+		return;
+	}
+	
+	pthread_mutex_lock(&pool->lock);
+	pool->task = task;
+	pool->context = context;
+	pool->task_count = task_count;
+	pool->next_task_index = 0;
+	pool->busy_worker_count = pool->worker_count;
+	pool->generation += 1;
+	pthread_cond_broadcast(&pool->run_started);
+	pthread_mutex_unlock(&pool->lock);
+	
+	jx_thread_pool_work_on_current_run(pool);
+	
+	pthread_mutex_lock(&pool->lock);
+	while (pool->busy_worker_count > 0) {
+		pthread_cond_wait(&pool->run_finished, &pool->lock);
+	}
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
@@ -0,0 +1,81 @@
+//
+//  thread-pool.h
+//  bit-ring-buffer
+//
+//  Created by agent on 2026-10-18.
+//
+//
+
+#ifndef LIBJX_THREAD_POOL_H
+#define LIBJX_THREAD_POOL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+
+/*-----------------------------------------------------------------------
+ * Thread pools
+ */
+
+/* A small, fixed-size pool of worker threads.
+ * The thread calling `jx_thread_pool_run()` takes part in the work,
+ * so a pool with a `thread_count` of 1 does not start any threads at all. */
+typedef struct jx_thread_pool jx_thread_pool;
+
+/* Called once for every task index in [0, task_count). */
+typedef void
+(*jx_thread_pool_task)(void *context, size_t task_index);
+
+/* Return a new pool with `thread_count` threads (including the caller),
+ * or NULL if the threads could not be started.
+ * A `thread_count` of 0 selects the number of online processors. */
+jx_thread_pool *
+jx_thread_pool_new(size_t thread_count);
+
+void
+jx_thread_pool_free(jx_thread_pool *pool);
+
+/* Return the number of threads (including the caller) working on each run. */
+size_t
+jx_thread_pool_get_thread_count(jx_thread_pool *pool);
+
+/* Run `task` for every task index and return once all of them are done.
+ * Runs must not overlap: only one thread may call this at a time. */
+void
+jx_thread_pool_run(jx_thread_pool *pool, jx_thread_pool_task task, void *context, size_t task_count);
+
+#endif /* LIBJX_THREAD_POOL_H */
+
+/*
+ Copyright 2026 agent
+ 
+ Some rights reserved: https://opensource.org/licenses/BSD-3-Clause
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright
+ notice, this list of conditions and the following disclaimer in
+ the documentation and/or other materials provided with the
+ distribution.
+ 
+ 3. Neither the name of the copyright holder nor the names of any
+ contributors may be used to endorse or promote products derived
+ from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */